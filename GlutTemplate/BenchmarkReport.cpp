@@ -0,0 +1,347 @@
+///////////////////////////////////////////////////////////////////////////////
+// BenchmarkReport.cpp
+// ===================
+// per-frame results of a benchmark run, written as JSON
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include "BenchmarkReport.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// quote a string for JSON
+///////////////////////////////////////////////////////////////////////////////
+static std::string quote(const std::string& str)
+{
+    std::string result = "\"";
+    for(size_t i = 0; i < str.size(); ++i)
+    {
+        unsigned char c = (unsigned char)str[i];
+        if(c == '"' || c == '\\')
+        {
+            result += '\\';
+            result += (char)c;
+        }
+        else if(c < 0x20)
+        {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            result += buffer;
+        }
+        else
+        {
+            result += (char)c;
+        }
+    }
+    return result + "\"";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a summary in ms as JSON object
+///////////////////////////////////////////////////////////////////////////////
+static void writeSummary(std::ostream& os, const FrameStats::Summary& s)
+{
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer),
+             "{ \"count\": %d, \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }",
+             s.count, s.mean, s.p50, s.p95, s.p99, s.max);
+    os << buffer;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+BenchmarkReport::BenchmarkReport()
+{
+}
+BenchmarkReport::~BenchmarkReport()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all frames and info
+///////////////////////////////////////////////////////////////////////////////
+void BenchmarkReport::clear()
+{
+    info.clear();
+    frames.clear();
+    phaseNames.clear();
+    phaseTotals.clear();
+    gpuPassNames.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add or replace a value of "info"
+///////////////////////////////////////////////////////////////////////////////
+void BenchmarkReport::setInfo(const std::string& key, const std::string& value)
+{
+    for(size_t i = 0; i < info.size(); ++i)
+    {
+        if(info[i].first == key)
+        {
+            info[i].second = value;
+            return;
+        }
+    }
+    info.push_back(std::make_pair(key, value));
+}
+
+void BenchmarkReport::setInfo(const std::string& key, long long value)
+{
+    std::stringstream ss;
+    ss << value;
+    setInfo(key, ss.str());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the latest finished frame of stats with its counters
+///////////////////////////////////////////////////////////////////////////////
+void BenchmarkReport::addFrame(const FrameStats& stats, int drawCalls, long long triangles, long long uploadBytes)
+{
+    if(stats.getCount() == 0)
+        return;
+
+    const FrameStats::Frame& f = stats.getFrame(0);
+    Frame frame;
+    frame.number = f.number;
+    frame.frameNs = f.frameNs;
+    frame.cpuNs = f.cpuNs;
+    frame.gpuNs = f.gpuNs;
+    for(int i = 0; i < FrameStats::MAX_PHASES; ++i)
+        frame.gpuPassNs[i] = f.gpuPassNs[i];
+    frame.drawCalls = drawCalls;
+    frame.triangles = triangles;
+    frame.uploadBytes = uploadBytes;
+    frames.push_back(frame);
+
+    int phaseCount = stats.getPhaseCount();
+    if((int)phaseNames.size() != phaseCount)
+    {
+        phaseNames.resize(phaseCount);
+        phaseTotals.resize(phaseCount, 0);
+        for(int i = 0; i < phaseCount; ++i)
+            phaseNames[i] = stats.getPhaseName(i);
+    }
+    for(int i = 0; i < phaseCount; ++i)
+        phaseTotals[i] += f.phaseNs[i];
+
+    if((int)gpuPassNames.size() != stats.getGpuPassCount())
+    {
+        gpuPassNames.resize(stats.getGpuPassCount());
+        for(int i = 0; i < (int)gpuPassNames.size(); ++i)
+            gpuPassNames[i] = stats.getGpuPassName(i);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// attach GPU pass times to a recorded frame
+///////////////////////////////////////////////////////////////////////////////
+void BenchmarkReport::setGpuTimes(unsigned long frameNumber, const long long* passNs)
+{
+    if(frames.empty() || frameNumber < frames[0].number)
+        return;
+
+    // frames are recorded in order, usually without gaps
+    Frame* frame = 0;
+    size_t index = frameNumber - frames[0].number;
+    if(index < frames.size() && frames[index].number == frameNumber)
+        frame = &frames[index];
+    for(size_t i = 0; i < frames.size() && !frame; ++i)
+    {
+        if(frames[i].number == frameNumber)
+            frame = &frames[i];
+    }
+    if(!frame)
+        return;
+
+    frame->gpuNs = -1;
+    for(size_t i = 0; i < gpuPassNames.size(); ++i)
+    {
+        frame->gpuPassNs[i] = passNs[i];
+        if(passNs[i] >= 0)
+            frame->gpuNs = (frame->gpuNs < 0 ? 0 : frame->gpuNs) + passNs[i];
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the report as JSON
+///////////////////////////////////////////////////////////////////////////////
+bool BenchmarkReport::save(const std::string& fileName) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+    {
+        std::cout << "[BenchmarkReport::save()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    // summaries of the whole run
+    std::vector<long long> frameNs, cpuNs, gpuNs;
+    long long drawTotal = 0, triangleTotal = 0, uploadTotal = 0;
+    int drawMax = 0;
+    long long triangleMax = 0, uploadMax = 0;
+    for(size_t i = 0; i < frames.size(); ++i)
+    {
+        const Frame& f = frames[i];
+        frameNs.push_back(f.frameNs);
+        cpuNs.push_back(f.cpuNs);
+        if(f.gpuNs >= 0)
+            gpuNs.push_back(f.gpuNs);
+        drawTotal += f.drawCalls;
+        triangleTotal += f.triangles;
+        drawMax = std::max(drawMax, f.drawCalls);
+        triangleMax = std::max(triangleMax, f.triangles);
+        uploadTotal += f.uploadBytes;
+        uploadMax = std::max(uploadMax, f.uploadBytes);
+    }
+    int count = (int)frames.size();
+    double divisor = count > 0 ? (double)count : 1.0;
+
+    file << "{\n  \"info\": {";
+    for(size_t i = 0; i < info.size(); ++i)
+        file << (i == 0 ? "\n" : ",\n") << "    " << quote(info[i].first) << ": " << quote(info[i].second);
+    file << "\n  },\n";
+
+    file << "  \"frameCount\": " << count << ",\n";
+    file << "  \"summary\": {\n";
+    file << "    \"frameMs\": ";
+    writeSummary(file, FrameStats::summarize(frameNs));
+    file << ",\n    \"cpuMs\": ";
+    writeSummary(file, FrameStats::summarize(cpuNs));
+    file << ",\n    \"gpuMs\": ";
+    writeSummary(file, FrameStats::summarize(gpuNs));
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), ",\n    \"drawCalls\": { \"mean\": %.2f, \"max\": %d }", drawTotal / divisor, drawMax);
+    file << buffer;
+    snprintf(buffer, sizeof(buffer), ",\n    \"triangles\": { \"mean\": %.1f, \"max\": %lld }", triangleTotal / divisor, triangleMax);
+    file << buffer;
+    snprintf(buffer, sizeof(buffer), ",\n    \"uploadBytes\": { \"mean\": %.1f, \"max\": %lld }", uploadTotal / divisor, uploadMax);
+    file << buffer;
+    file << "\n  },\n";
+
+    file << "  \"gpuPassMs\": {";
+    for(size_t p = 0; p < gpuPassNames.size(); ++p)
+    {
+        std::vector<long long> passNs;
+        for(size_t i = 0; i < frames.size(); ++i)
+        {
+            if(frames[i].gpuPassNs[p] >= 0)
+                passNs.push_back(frames[i].gpuPassNs[p]);
+        }
+        file << (p == 0 ? "\n" : ",\n") << "    " << quote(gpuPassNames[p]) << ": ";
+        writeSummary(file, FrameStats::summarize(passNs));
+    }
+    file << "\n  },\n";
+
+    file << "  \"phaseMeanMs\": {";
+    for(size_t i = 0; i < phaseNames.size(); ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%.4f", phaseTotals[i] * 1e-6 / divisor);
+        file << (i == 0 ? " " : ", ") << quote(phaseNames[i]) << ": " << buffer;
+    }
+    file << " },\n";
+
+    file << "  \"frames\": [";
+    for(size_t i = 0; i < frames.size(); ++i)
+    {
+        const Frame& f = frames[i];
+        snprintf(buffer, sizeof(buffer),
+                 "%s\n    { \"frame\": %lu, \"ms\": %.4f, \"cpuMs\": %.4f, \"gpuMs\": %.4f, \"drawCalls\": %d, \"triangles\": %lld, \"uploadBytes\": %lld, \"gpuPassMs\": [",
+                 i == 0 ? "" : ",", f.number, f.frameNs * 1e-6, f.cpuNs * 1e-6,
+                 f.gpuNs >= 0 ? f.gpuNs * 1e-6 : -1.0, f.drawCalls, f.triangles, f.uploadBytes);
+        file << buffer;
+        for(size_t p = 0; p < gpuPassNames.size(); ++p)
+        {
+            snprintf(buffer, sizeof(buffer), "%s%.4f", p == 0 ? " " : ", ", f.gpuPassNs[p] >= 0 ? f.gpuPassNs[p] * 1e-6 : -1.0);
+            file << buffer;
+        }
+        file << " ] }";
+    }
+    file << "\n  ]\n}\n";
+
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// summary of the frame times of all frames added, as in the JSON
+///////////////////////////////////////////////////////////////////////////////
+FrameStats::Summary BenchmarkReport::getFrameSummary() const
+{
+    std::vector<long long> frameNs;
+    for(size_t i = 0; i < frames.size(); ++i)
+        frameNs.push_back(frames[i].frameNs);
+    return FrameStats::summarize(frameNs);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append the summary of the run as a CSV row, with header if the file is new
+///////////////////////////////////////////////////////////////////////////////
+bool BenchmarkReport::appendCsv(const std::string& fileName, const std::string& method, int objects, long peakRssKb) const
+{
+    bool empty = true;
+    {
+        std::ifstream in(fileName.c_str(), std::ios::binary | std::ios::ate);
+        if(in && in.tellg() > 0)
+            empty = false;
+    }
+
+    std::ofstream file(fileName.c_str(), std::ios::app);
+    if(!file)
+    {
+        std::cout << "[BenchmarkReport::appendCsv()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    std::vector<long long> frameNs, cpuNs, gpuNs;
+    long long drawTotal = 0, uploadTotal = 0;
+    for(size_t i = 0; i < frames.size(); ++i)
+    {
+        frameNs.push_back(frames[i].frameNs);
+        cpuNs.push_back(frames[i].cpuNs);
+        if(frames[i].gpuNs >= 0)
+            gpuNs.push_back(frames[i].gpuNs);
+        drawTotal += frames[i].drawCalls;
+        uploadTotal += frames[i].uploadBytes;
+    }
+    double divisor = frames.empty() ? 1.0 : (double)frames.size();
+    FrameStats::Summary frame = FrameStats::summarize(frameNs);
+    FrameStats::Summary cpu = FrameStats::summarize(cpuNs);
+    FrameStats::Summary gpu = FrameStats::summarize(gpuNs);
+
+    if(empty)
+        file << "method,objects,frames,mean_ms,p99_ms,cpu_mean_ms,gpu_mean_ms,draw_calls,upload_bytes,peak_rss_kb\n";
+
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%.1f,%.0f,%ld\n",
+             method.c_str(), objects, (int)frames.size(), frame.mean, frame.p99, cpu.mean, gpu.mean,
+             drawTotal / divisor, uploadTotal / divisor, peakRssKb);
+    file << buffer;
+    return (bool)file;
+}
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// BenchmarkReport.h
+// =================
+// per-frame results of a benchmark run, written as JSON
+//
+// Unlike FrameStats, which keeps only the recent frames for the HUD, the
+// report keeps every frame of the run, so the summary covers all of them.
+// The GPU times of a frame arrive a few frames later and are attached with
+// setGpuTimes() by frame number, one time per pass as in FrameStats.
+// appendCsv() adds a one-line summary of the run to a CSV file, for sweeps
+// over many runs.
+// The output has an "info" object of string pairs (renderer, object count,
+// etc.), a "summary" with mean/p50/p95/p99/max of each time in ms and the
+// mean/max of counters, the same summary for each GPU pass, the mean of each
+// CPU phase, and the "frames" array.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHMARK_REPORT_H
+#define BENCHMARK_REPORT_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "FrameStats.h"
+
+class BenchmarkReport
+{
+public:
+    BenchmarkReport();
+    ~BenchmarkReport();
+
+    void clear();
+    void setInfo(const std::string& key, const std::string& value);
+    void setInfo(const std::string& key, long long value);
+    void addFrame(const FrameStats& stats, int drawCalls, long long triangles, long long uploadBytes);  // latest frame of stats
+    void setGpuTimes(unsigned long frameNumber, const long long* passNs);
+    bool save(const std::string& fileName) const;
+    bool appendCsv(const std::string& fileName, const std::string& method, int objects, long peakRssKb) const;
+
+    int getFrameCount() const                       { return (int)frames.size(); }
+    FrameStats::Summary getFrameSummary() const;    // frame times of the whole run
+
+private:
+    struct Frame
+    {
+        unsigned long number;
+        long long frameNs;
+        long long cpuNs;
+        long long gpuNs;                            // -1 if not measured
+        long long gpuPassNs[FrameStats::MAX_PHASES];
+        int drawCalls;
+        long long triangles;
+        long long uploadBytes;                      // instance data sent to GL
+    };
+
+    std::vector<std::pair<std::string, std::string> > info;
+    std::vector<Frame> frames;
+    std::vector<std::string> phaseNames;
+    std::vector<long long> phaseTotals;             // ns summed over frames
+    std::vector<std::string> gpuPassNames;
+};
+
+#endif
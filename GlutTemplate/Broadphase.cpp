@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////////////////////////
+// Broadphase.cpp
+// ==============
+// sort-and-sweep collision broadphase over axis-aligned bounding boxes
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include "Broadphase.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BROADPHASE_SSE
+#endif
+
+// below this number of boxes per thread, sweeping on one thread is faster
+const int MIN_BOXES_PER_THREAD = 4096;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+Broadphase::Broadphase(int threadCount) : threadCount(threadCount), axis(0), generation(0), activeRanges(0),
+                                          chunk(0), busyWorkers(0), quitting(false)
+{
+    if(this->threadCount <= 0)
+        this->threadCount = (int)std::thread::hardware_concurrency();
+    if(this->threadCount <= 0)
+        this->threadCount = 1;
+    threadPairs.resize(this->threadCount);
+}
+Broadphase::~Broadphase()
+{
+    stopWorkers();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create the worker threads, called by the first sweep split across threads
+// Each worker starts from the current generation, so it waits for the next
+// sweep instead of taking an old one.
+///////////////////////////////////////////////////////////////////////////////
+void Broadphase::startWorkers()
+{
+    for(int t = 1; t < threadCount; ++t)
+        workers.push_back(std::thread(&Broadphase::work, this, t, generation));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// join the worker threads; the next split sweep creates them again
+///////////////////////////////////////////////////////////////////////////////
+void Broadphase::stopWorkers()
+{
+    if(workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quitting = true;
+    }
+    startCondition.notify_all();
+    for(size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+    workers.clear();
+    quitting = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find overlapping pairs
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<Broadphase::Pair>& Broadphase::findPairs(const float* minX, const float* minY, const float* minZ,
+                                                           const float* maxX, const float* maxY, const float* maxZ, int count)
+{
+    pairs.clear();
+    if(count < 2)
+        return pairs;
+
+    const float* min[3] = { minX, minY, minZ };
+    const float* max[3] = { maxX, maxY, maxZ };
+    axis = chooseAxis(min, max, count);
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+
+    // sort by minimum on sweep axis
+    keys.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        keys[i].key = min[axis][i];
+        keys[i].index = i;
+    }
+    std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) { return a.key < b.key; });
+
+    // gather boxes in sorted order, pad with boxes that never overlap
+    const float inf = std::numeric_limits<float>::max();
+    int padded = (count + 3) & ~3;
+    sMin.resize(padded);  sMax.resize(padded);
+    uMin.resize(padded);  uMax.resize(padded);
+    vMin.resize(padded);  vMax.resize(padded);
+    order.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        int index = keys[i].index;
+        order[i] = index;
+        sMin[i] = min[axis][index];  sMax[i] = max[axis][index];
+        uMin[i] = min[u][index];     uMax[i] = max[u][index];
+        vMin[i] = min[v][index];     vMax[i] = max[v][index];
+    }
+    for(int i = count; i < padded; ++i)
+    {
+        sMin[i] = uMin[i] = vMin[i] = inf;
+        sMax[i] = uMax[i] = vMax[i] = -inf;
+    }
+
+    // split sweep across threads; the calling thread takes the first range
+    int threads = std::min(threadCount, count / MIN_BOXES_PER_THREAD);
+    if(threads <= 1)
+    {
+        sweep(0, count, pairs);
+        return pairs;
+    }
+
+    if(workers.empty())
+        startWorkers();
+
+    // wake all workers; the ones beyond the active ranges finish at once
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk = (count + threads - 1) / threads;
+        activeRanges = threads;
+        busyWorkers = (int)workers.size();
+        ++generation;
+    }
+    startCondition.notify_all();
+    sweep(0, std::min(chunk, count), pairs);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    }
+    for(int t = 1; t < threads; ++t)
+        pairs.insert(pairs.end(), threadPairs[t].begin(), threadPairs[t].end());
+    return pairs;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// worker thread, waits for each sweep handed out by findPairs()
+///////////////////////////////////////////////////////////////////////////////
+void Broadphase::work(int worker, unsigned long seen)
+{
+    while(true)
+    {
+        int begin = 0, end = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [this, seen] { return quitting || generation != seen; });
+            if(quitting)
+                return;
+            seen = generation;
+            if(worker < activeRanges)
+            {
+                int count = (int)order.size();
+                begin = std::min(worker * chunk, count);
+                end = std::min(begin + chunk, count);
+            }
+        }
+
+        threadPairs[worker].clear();
+        if(begin < end)
+            sweep(begin, end, threadPairs[worker]);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = --busyWorkers == 0;
+        }
+        if(last)
+            doneCondition.notify_one();
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// choose the axis with the largest variance of box centers
+///////////////////////////////////////////////////////////////////////////////
+int Broadphase::chooseAxis(const float* min[3], const float* max[3], int count)
+{
+    float variance[3];
+    for(int a = 0; a < 3; ++a)
+    {
+        double sum = 0, sum2 = 0;
+        for(int i = 0; i < count; ++i)
+        {
+            double c = (min[a][i] + max[a][i]) * 0.5;
+            sum += c;
+            sum2 += c * c;
+        }
+        double mean = sum / count;
+        variance[a] = (float)(sum2 / count - mean * mean);
+    }
+
+    int best = 0;
+    if(variance[1] > variance[best]) best = 1;
+    if(variance[2] > variance[best]) best = 2;
+    return best;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sweep sorted boxes [begin, end) against all following boxes
+///////////////////////////////////////////////////////////////////////////////
+void Broadphase::sweep(int begin, int end, std::vector<Pair>& result)
+{
+    int count = (int)order.size();
+    for(int i = begin; i < end; ++i)
+    {
+        const float maxS = sMax[i];
+        int j = i + 1;
+
+#ifdef BROADPHASE_SSE
+        // scalar until j is a multiple of 4, then 4 candidates per iteration
+        while(j < count && (j & 3) && sMin[j] <= maxS)
+        {
+            if(uMin[j] <= uMax[i] && uMax[j] >= uMin[i] && vMin[j] <= vMax[i] && vMax[j] >= vMin[i])
+            {
+                Pair pair = { order[i], order[j] };
+                result.push_back(pair);
+            }
+            ++j;
+        }
+        if(j < count && (j & 3) == 0)
+        {
+            const __m128 maxS4 = _mm_set1_ps(maxS);
+            const __m128 minU4 = _mm_set1_ps(uMin[i]);
+            const __m128 maxU4 = _mm_set1_ps(uMax[i]);
+            const __m128 minV4 = _mm_set1_ps(vMin[i]);
+            const __m128 maxV4 = _mm_set1_ps(vMax[i]);
+            while(j < count && sMin[j] <= maxS)
+            {
+                __m128 mask = _mm_cmple_ps(_mm_loadu_ps(&sMin[j]), maxS4);
+                mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_loadu_ps(&uMin[j]), maxU4));
+                mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_loadu_ps(&uMax[j]), minU4));
+                mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_loadu_ps(&vMin[j]), maxV4));
+                mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_loadu_ps(&vMax[j]), minV4));
+                int bits = _mm_movemask_ps(mask);
+                while(bits)
+                {
+                    int k = 0;
+                    while(!(bits & (1 << k)))
+                        ++k;
+                    bits &= ~(1 << k);
+                    if(j + k < count)
+                    {
+                        Pair pair = { order[i], order[j + k] };
+                        result.push_back(pair);
+                    }
+                }
+                j += 4;
+            }
+        }
+#else
+        for(; j < count && sMin[j] <= maxS; ++j)
+        {
+            if(uMin[j] <= uMax[i] && uMax[j] >= uMin[i] && vMin[j] <= vMax[i] && vMax[j] >= vMin[i])
+            {
+                Pair pair = { order[i], order[j] };
+                result.push_back(pair);
+            }
+        }
+#endif
+    }
+}
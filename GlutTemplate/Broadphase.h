@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// Broadphase.h
+// ============
+// sort-and-sweep collision broadphase over axis-aligned bounding boxes
+//
+// Boxes are sorted by their minimum along the axis with the largest variance
+// of box centers, which keeps the sweep intervals short. Each box is then
+// swept against the following boxes until their minimum passes its maximum;
+// the overlap tests on the other two axes are done 4 boxes at a time with SSE.
+// The sweep is split across worker threads by ranges of sorted boxes; every
+// thread writes its own pair list. The workers are created by the first
+// sweep large enough to split, not by the constructor, since a Broadphase
+// may be a static object; they then wait on a condition variable between
+// calls, because findPairs() runs every simulation step and creating threads
+// each time would cost more than a short sweep. stopWorkers() or the
+// destructor joins them.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class Broadphase
+{
+public:
+    struct Pair
+    {
+        int a, b;                                   // indices of overlapping boxes
+    };
+
+    Broadphase(int threadCount=0);                  // 0: use hardware concurrency
+    ~Broadphase();
+
+    // find all overlapping pairs of boxes given as SoA arrays
+    const std::vector<Pair>& findPairs(const float* minX, const float* minY, const float* minZ,
+                                       const float* maxX, const float* maxY, const float* maxZ, int count);
+
+    const std::vector<Pair>& getPairs() const       { return pairs; }
+    int getAxis() const                             { return axis; }        // 0:x, 1:y, 2:z
+    int getThreadCount() const                      { return threadCount; }
+
+    void stopWorkers();                             // join worker threads, not during findPairs()
+
+private:
+    struct SortKey
+    {
+        float key;
+        int index;
+    };
+
+    int  chooseAxis(const float* min[3], const float* max[3], int count);
+    void sweep(int begin, int end, std::vector<Pair>& result);
+    void startWorkers();
+    void work(int worker, unsigned long seen);      // loop of worker thread, sweeps range worker
+
+    Broadphase(const Broadphase& rhs);              // no implementation
+
+    int threadCount;
+    int axis;
+    std::vector<SortKey> keys;
+    // sorted boxes, sweep axis first; padded to a multiple of 4 with empty boxes
+    std::vector<float> sMin, sMax, uMin, uMax, vMin, vMax;
+    std::vector<int> order;                         // sorted position to box index
+    std::vector<std::vector<Pair> > threadPairs;
+    std::vector<Pair> pairs;
+
+    // worker pool, threadCount-1 threads; the calling thread sweeps range 0
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    unsigned long generation;                       // incremented for each sweep handed to workers
+    int activeRanges;                               // ranges of the current sweep, including range 0
+    int chunk;                                      // sorted boxes per range
+    int busyWorkers;                                // workers not finished with the current sweep
+    bool quitting;
+};
+
+#endif
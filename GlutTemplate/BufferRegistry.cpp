@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////
+// BufferRegistry.cpp
+// ==================
+// keeps the size, target, usage hint and owner of every buffer object made by
+// createVBO()
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include "BufferRegistry.h"
+
+namespace
+{
+    BufferRegistry::Buffer buffers[BufferRegistry::MAX_BUFFERS];
+    int bufferCount = 0;
+    long long liveBytes = 0;
+    int peakCount = 0;
+    long long peakBytes = 0;
+    int untrackedCount = 0;                         // added while the array was full
+    bool validation = false;
+
+    int indexOf(GLuint id)
+    {
+        for(int i = 0; i < bufferCount; ++i)
+        {
+            if(buffers[i].id == id)
+                return i;
+        }
+        return -1;
+    }
+
+    void updatePeaks()
+    {
+        if(bufferCount > peakCount)
+            peakCount = bufferCount;
+        if(liveBytes > peakBytes)
+            peakBytes = liveBytes;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a buffer created with glBufferData() of the given size
+///////////////////////////////////////////////////////////////////////////////
+void BufferRegistry::add(GLuint id, GLenum target, GLenum usage, long long size, const char* owner)
+{
+    if(id == 0)
+        return;
+
+    int i = indexOf(id);
+    if(i >= 0)
+    {
+        // the name was deleted behind deleteVBO() and reused by GL
+        liveBytes -= buffers[i].size;
+    }
+    else if(bufferCount < MAX_BUFFERS)
+    {
+        i = bufferCount++;
+    }
+    else
+    {
+        if(untrackedCount++ == 0)
+            std::cout << "[WARNING] More than " << MAX_BUFFERS << " buffers, the rest are not tracked." << std::endl;
+        return;
+    }
+
+    Buffer& b = buffers[i];
+    b.id = id;
+    b.target = target;
+    b.usage = usage;
+    b.size = size;
+    b.owner = owner ? owner : "unknown";
+    b.validated = false;
+    liveBytes += size;
+    updatePeaks();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove a deleted buffer; the last record moves into its slot
+///////////////////////////////////////////////////////////////////////////////
+void BufferRegistry::remove(GLuint id)
+{
+    int i = id ? indexOf(id) : -1;
+    if(i < 0)
+        return;
+
+    liveBytes -= buffers[i].size;
+    buffers[i] = buffers[--bufferCount];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the new size after the buffer is re-specified by glBufferData()
+///////////////////////////////////////////////////////////////////////////////
+void BufferRegistry::resize(GLuint id, long long size)
+{
+    int i = id ? indexOf(id) : -1;
+    if(i < 0 || buffers[i].size == size)
+        return;
+
+    liveBytes += size - buffers[i].size;
+    buffers[i].size = size;
+    buffers[i].validated = false;
+    updatePeaks();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters
+///////////////////////////////////////////////////////////////////////////////
+int BufferRegistry::getLiveCount()
+{
+    return bufferCount;
+}
+
+long long BufferRegistry::getLiveBytes()
+{
+    return liveBytes;
+}
+
+int BufferRegistry::getPeakCount()
+{
+    return peakCount;
+}
+
+long long BufferRegistry::getPeakBytes()
+{
+    return peakBytes;
+}
+
+const BufferRegistry::Buffer* BufferRegistry::find(GLuint id)
+{
+    int i = id ? indexOf(id) : -1;
+    return i >= 0 ? &buffers[i] : 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// turn the deferred size check on/off
+///////////////////////////////////////////////////////////////////////////////
+void BufferRegistry::setValidation(bool flag)
+{
+    validation = flag;
+}
+
+bool BufferRegistry::getValidation()
+{
+    return validation;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare GL_BUFFER_SIZE with the registered size of the buffers added or
+// resized since the last call, and return the number of mismatches
+// A buffer can be bound to any target, so each one is queried through
+// GL_ARRAY_BUFFER, and the binding of the caller is restored afterwards.
+///////////////////////////////////////////////////////////////////////////////
+int BufferRegistry::validate()
+{
+    if(!validation)
+        return 0;
+
+    int mismatches = 0;
+    GLint binding = -1;
+    for(int i = 0; i < bufferCount; ++i)
+    {
+        Buffer& b = buffers[i];
+        if(b.validated)
+            continue;
+
+        if(binding < 0)
+            glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &binding);
+        GLint size = 0;
+        glBindBuffer(GL_ARRAY_BUFFER, b.id);
+        glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
+        b.validated = true;
+        if(size != b.size)
+        {
+            std::cout << "[BufferRegistry::validate()] Buffer " << b.id << " of " << b.owner << " has "
+                      << size << " bytes, " << b.size << " bytes requested." << std::endl;
+            ++mismatches;
+        }
+    }
+    if(binding >= 0)
+        glBindBuffer(GL_ARRAY_BUFFER, binding);
+
+    return mismatches;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the buffers still alive, call after the owners are released
+///////////////////////////////////////////////////////////////////////////////
+int BufferRegistry::reportLeaks(std::ostream& os)
+{
+    os << "Buffers: peak " << peakCount << " buffers, " << peakBytes << " bytes";
+    if(untrackedCount > 0)
+        os << ", " << untrackedCount << " not tracked";
+    if(bufferCount == 0)
+    {
+        os << ", no leaks." << std::endl;
+        return 0;
+    }
+    os << ", " << bufferCount << " not deleted (" << liveBytes << " bytes):" << std::endl;
+
+    char line[128];
+    for(int i = 0; i < bufferCount; ++i)
+    {
+        const Buffer& b = buffers[i];
+        snprintf(line, sizeof(line), "%8u  %12lld bytes  %-28s %-15s ", b.id, b.size,
+                 getTargetName(b.target), getUsageName(b.usage));
+        os << line << b.owner << std::endl;
+    }
+    return bufferCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// names of the enums, for the report
+///////////////////////////////////////////////////////////////////////////////
+const char* BufferRegistry::getUsageName(GLenum usage)
+{
+    switch(usage)
+    {
+    case GL_STREAM_DRAW:    return "GL_STREAM_DRAW";
+    case GL_STREAM_READ:    return "GL_STREAM_READ";
+    case GL_STREAM_COPY:    return "GL_STREAM_COPY";
+    case GL_STATIC_DRAW:    return "GL_STATIC_DRAW";
+    case GL_STATIC_READ:    return "GL_STATIC_READ";
+    case GL_STATIC_COPY:    return "GL_STATIC_COPY";
+    case GL_DYNAMIC_DRAW:   return "GL_DYNAMIC_DRAW";
+    case GL_DYNAMIC_READ:   return "GL_DYNAMIC_READ";
+    case GL_DYNAMIC_COPY:   return "GL_DYNAMIC_COPY";
+    default:                return "unknown";
+    }
+}
+
+const char* BufferRegistry::getTargetName(GLenum target)
+{
+    switch(target)
+    {
+    case GL_ARRAY_BUFFER:               return "GL_ARRAY_BUFFER";
+    case GL_ELEMENT_ARRAY_BUFFER:       return "GL_ELEMENT_ARRAY_BUFFER";
+    case GL_COPY_READ_BUFFER:           return "GL_COPY_READ_BUFFER";
+    case GL_COPY_WRITE_BUFFER:          return "GL_COPY_WRITE_BUFFER";
+    case GL_PIXEL_PACK_BUFFER:          return "GL_PIXEL_PACK_BUFFER";
+    case GL_PIXEL_UNPACK_BUFFER:        return "GL_PIXEL_UNPACK_BUFFER";
+    case GL_TRANSFORM_FEEDBACK_BUFFER:  return "GL_TRANSFORM_FEEDBACK_BUFFER";
+    case GL_UNIFORM_BUFFER:             return "GL_UNIFORM_BUFFER";
+    default:                            return "unknown";
+    }
+}
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+// BufferRegistry.h
+// ================
+// keeps the size, target, usage hint and owner of every buffer object made by
+// createVBO(), for the memory totals in the HUD and the leak report at exit
+//
+// createVBO() adds a buffer and deleteVBO() removes it; code re-specifying a
+// buffer with glBufferData() of another size calls resize(). The live and
+// peak totals are the sizes requested from GL, not what the driver actually
+// allocates.
+// createVBO() used to read GL_BUFFER_SIZE back after every upload, which
+// waits for the driver. The check is now deferred and optional: with
+// setValidation(true), validate() queries the buffers added or resized since
+// its last call, so calling it once per frame costs nothing in most frames.
+// The records are kept in a fixed array, not in a container with a
+// destructor, since owners may release their buffers during static
+// destruction. Buffers beyond MAX_BUFFERS are not tracked.
+// Like the GL calls themselves, it is for the render thread only.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BUFFER_REGISTRY_H
+#define BUFFER_REGISTRY_H
+
+#include <iostream>
+#include "glExtension.h"
+
+class BufferRegistry
+{
+public:
+    static const int MAX_BUFFERS = 1024;
+
+    struct Buffer
+    {
+        GLuint id;
+        GLenum target;                              // target at creation
+        GLenum usage;
+        long long size;                             // bytes
+        const char* owner;                          // not copied, use string literals
+        bool validated;                             // size checked by validate()
+    };
+
+    static void add(GLuint id, GLenum target, GLenum usage, long long size, const char* owner);
+    static void remove(GLuint id);                  // unknown ids are ignored
+    static void resize(GLuint id, long long size);
+
+    static int getLiveCount();
+    static long long getLiveBytes();
+    static int getPeakCount();
+    static long long getPeakBytes();
+    static const Buffer* find(GLuint id);           // 0 if not tracked
+
+    static void setValidation(bool flag);
+    static bool getValidation();
+    static int validate();                          // check new buffers if enabled, return mismatches
+    static int reportLeaks(std::ostream& os);       // list live buffers, return count
+
+    static const char* getUsageName(GLenum usage);
+    static const char* getTargetName(GLenum target);
+};
+
+#endif
@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////
+// Camera.cpp
+// ==========
+// view and projection matrices computed on CPU
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include "Camera.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+Camera::Camera() : fovY(60), nearZ(0.1f), farZ(100), viewportWidth(1), viewportHeight(1),
+                   version(1), derivedVersion(0)
+{
+    updateProjection();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set view matrix same as gluLookAt()
+///////////////////////////////////////////////////////////////////////////////
+void Camera::lookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+{
+    setViewMatrix(Mat4::lookAt(eye, target, up));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set view matrix; nothing changes if it is the same as before
+///////////////////////////////////////////////////////////////////////////////
+void Camera::setViewMatrix(const Mat4& view)
+{
+    if(memcmp(this->view.m, view.m, sizeof(view.m)) == 0)
+        return;
+
+    this->view = view;
+    ++version;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set perspective projection parameters, aspect ratio comes from viewport
+///////////////////////////////////////////////////////////////////////////////
+void Camera::setPerspective(float fovY, float nearZ, float farZ)
+{
+    if(this->fovY == fovY && this->nearZ == nearZ && this->farZ == farZ)
+        return;
+
+    this->fovY = fovY;
+    this->nearZ = nearZ;
+    this->farZ = farZ;
+    updateProjection();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set window size, called from reshapeCB()
+///////////////////////////////////////////////////////////////////////////////
+void Camera::setViewport(int width, int height)
+{
+    if(height < 1)
+        height = 1;
+    if(viewportWidth == width && viewportHeight == height)
+        return;
+
+    viewportWidth = width;
+    viewportHeight = height;
+    updateProjection();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return projection * view, recomputed only after a change
+///////////////////////////////////////////////////////////////////////////////
+const Mat4& Camera::getViewProjectionMatrix() const
+{
+    updateDerived();
+    return viewProjection;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return 6 frustum planes (left, right, bottom, top, near, far) in world space
+// A point p is inside if dot(plane.xyz, p) + plane.w >= 0 for all planes.
+///////////////////////////////////////////////////////////////////////////////
+void Camera::getFrustumPlanes(Vec4 planes[6]) const
+{
+    updateDerived();
+    for(int i = 0; i < 6; ++i)
+        planes[i] = frustumPlanes[i];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// eye position is -R^T * t of the rigid view matrix
+///////////////////////////////////////////////////////////////////////////////
+Vec3 Camera::getPosition() const
+{
+    const float* m = view.m;
+    return Vec3(-(m[0] * m[12] + m[1] * m[13] + m[2]  * m[14]),
+                -(m[4] * m[12] + m[5] * m[13] + m[6]  * m[14]),
+                -(m[8] * m[12] + m[9] * m[13] + m[10] * m[14]));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// rebuild projection matrix from fov, aspect and clip distances
+///////////////////////////////////////////////////////////////////////////////
+void Camera::updateProjection()
+{
+    projection = Mat4::perspective(fovY, (float)viewportWidth / viewportHeight, nearZ, farZ);
+    ++version;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// recompute view-projection matrix and frustum planes if camera changed
+// The planes are the sums/differences of the 4th row with the other rows of
+// the view-projection matrix (Gribb-Hartmann), then normalized.
+///////////////////////////////////////////////////////////////////////////////
+void Camera::updateDerived() const
+{
+    if(derivedVersion == version)
+        return;
+
+    viewProjection = projection * view;
+
+    const Mat4& m = viewProjection;
+    for(int i = 0; i < 3; ++i)
+    {
+        Vec4 row(m.at(i, 0), m.at(i, 1), m.at(i, 2), m.at(i, 3));
+        Vec4 last(m.at(3, 0), m.at(3, 1), m.at(3, 2), m.at(3, 3));
+        frustumPlanes[i * 2]     = last + row;
+        frustumPlanes[i * 2 + 1] = last - row;
+    }
+    for(int i = 0; i < 6; ++i)
+    {
+        float len = length(frustumPlanes[i].xyz());
+        if(len > 0)
+            frustumPlanes[i] = frustumPlanes[i] * (1.0f / len);
+    }
+
+    derivedVersion = version;
+}
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// Camera.h
+// ========
+// view and projection matrices computed on CPU
+//
+// The camera replaces gluLookAt()/gluPerspective(), so the matrices are
+// available to the application, e.g. for culling, instead of only inside the
+// GL matrix stack. The view-projection matrix and the frustum planes are
+// derived lazily and cached until the view or projection changes.
+// getVersion() changes whenever any matrix changes; shaders compare it with
+// the version they uploaded last and skip glUniformMatrix*() if it is same.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "VectorMath.h"
+
+class Camera
+{
+public:
+    Camera();
+    ~Camera() {}
+
+    // view
+    void lookAt(const Vec3& eye, const Vec3& target, const Vec3& up=Vec3(0, 1, 0));
+    void setViewMatrix(const Mat4& view);
+
+    // projection
+    void setPerspective(float fovY, float nearZ, float farZ);   // fovY in degree
+    void setViewport(int width, int height);        // window size, sets aspect ratio
+
+    const Mat4& getViewMatrix() const               { return view; }
+    const Mat4& getProjectionMatrix() const         { return projection; }
+    const Mat4& getViewProjectionMatrix() const;
+    void getFrustumPlanes(Vec4 planes[6]) const;    // world space, normals point inside
+    Vec3 getPosition() const;                       // eye position in world space
+
+    int   getViewportWidth() const                  { return viewportWidth; }
+    int   getViewportHeight() const                 { return viewportHeight; }
+    float getFovY() const                           { return fovY; }
+    unsigned int getVersion() const                 { return version; }
+
+private:
+    void updateProjection();
+    void updateDerived() const;
+
+    Mat4 view;
+    Mat4 projection;
+    float fovY;
+    float nearZ;
+    float farZ;
+    int viewportWidth;
+    int viewportHeight;
+    unsigned int version;                           // incremented when view or projection changes
+
+    // cached values derived from view and projection
+    mutable Mat4 viewProjection;
+    mutable Vec4 frustumPlanes[6];
+    mutable unsigned int derivedVersion;
+};
+
+#endif
@@ -0,0 +1,278 @@
+///////////////////////////////////////////////////////////////////////////////
+// CameraPath.cpp
+// ==============
+// camera flight path recorded as keyframes and replayed along a spline
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "CameraPath.h"
+
+// uniform Catmull-Rom interpolation between p1 and p2, t in [0, 1]
+static Vec3 catmullRom(const Vec3& p0, const Vec3& p1, const Vec3& p2, const Vec3& p3, float t)
+{
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return (p1 * 2.0f + (p2 - p0) * t + (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * t2 +
+            (p1 * 3.0f - p0 - p2 * 3.0f + p3) * t3) * 0.5f;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+CameraPath::CameraPath() : lastSegment(-1)
+{
+}
+CameraPath::~CameraPath()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all keyframes and statistics
+///////////////////////////////////////////////////////////////////////////////
+void CameraPath::clear()
+{
+    keys.clear();
+    stats.clear();
+    lastSegment = -1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append a keyframe; the time must not be before the last keyframe
+///////////////////////////////////////////////////////////////////////////////
+void CameraPath::addKey(float time, const Vec3& eye, const Vec3& target, const Vec3& up)
+{
+    if(!keys.empty() && time < keys.back().time)
+        return;
+
+    Key key = { time, eye, target, up };
+    keys.push_back(key);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write keyframes to a text file, one keyframe per line:
+// time eyeX eyeY eyeZ targetX targetY targetZ upX upY upZ
+///////////////////////////////////////////////////////////////////////////////
+bool CameraPath::save(const std::string& fileName) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+    {
+        std::cout << "[CameraPath::save()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    file << "# time eye(x,y,z) target(x,y,z) up(x,y,z)\n";
+    file << std::setprecision(9);
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+        const Key& k = keys[i];
+        file << k.time << ' '
+             << k.eye.x << ' ' << k.eye.y << ' ' << k.eye.z << ' '
+             << k.target.x << ' ' << k.target.y << ' ' << k.target.z << ' '
+             << k.up.x << ' ' << k.up.y << ' ' << k.up.z << '\n';
+    }
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read keyframes written by save(); lines starting with # are ignored
+///////////////////////////////////////////////////////////////////////////////
+bool CameraPath::load(const std::string& fileName)
+{
+    std::ifstream file(fileName.c_str());
+    if(!file)
+    {
+        std::cout << "[CameraPath::load()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    clear();
+    std::string line;
+    int lineNumber = 0;
+    while(std::getline(file, line))
+    {
+        ++lineNumber;
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream iss(line);
+        Key k;
+        if(!(iss >> k.time >> k.eye.x >> k.eye.y >> k.eye.z
+                 >> k.target.x >> k.target.y >> k.target.z >> k.up.x >> k.up.y >> k.up.z))
+        {
+            std::cout << "[CameraPath::load()] Invalid keyframe at line " << lineNumber << " of " << fileName << std::endl;
+            clear();
+            return false;
+        }
+        if(!keys.empty() && k.time < keys.back().time)
+        {
+            std::cout << "[CameraPath::load()] Keyframe time goes backward at line " << lineNumber << std::endl;
+            clear();
+            return false;
+        }
+        keys.push_back(k);
+    }
+
+    if(keys.size() < 2)
+    {
+        std::cout << "[CameraPath::load()] " << fileName << " needs at least 2 keyframes" << std::endl;
+        clear();
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the index of segment [keys[i], keys[i+1]) containing the time
+///////////////////////////////////////////////////////////////////////////////
+int CameraPath::getSegment(float time) const
+{
+    int count = (int)keys.size() - 1;
+    if(count < 1)
+        return 0;
+
+    // binary search for the last key at or before the time
+    int lo = 0;
+    int hi = count;
+    while(hi - lo > 1)
+    {
+        int mid = (lo + hi) / 2;
+        if(keys[mid].time <= time)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute camera at the time on the spline through the keyframes
+// The end keys are duplicated for the tangents of the first/last segment.
+///////////////////////////////////////////////////////////////////////////////
+void CameraPath::evaluate(float time, Vec3& eye, Vec3& target, Vec3& up) const
+{
+    if(keys.empty())
+        return;
+    if(keys.size() == 1 || time <= keys.front().time)
+    {
+        eye = keys.front().eye;
+        target = keys.front().target;
+        up = keys.front().up;
+        return;
+    }
+    if(time >= keys.back().time)
+    {
+        eye = keys.back().eye;
+        target = keys.back().target;
+        up = keys.back().up;
+        return;
+    }
+
+    int last = (int)keys.size() - 1;
+    int i = getSegment(time);
+    const Key& k0 = keys[i > 0 ? i - 1 : 0];
+    const Key& k1 = keys[i];
+    const Key& k2 = keys[i + 1];
+    const Key& k3 = keys[i + 2 <= last ? i + 2 : last];
+
+    float span = k2.time - k1.time;
+    float t = span > 0 ? (time - k1.time) / span : 0;
+    eye    = catmullRom(k0.eye, k1.eye, k2.eye, k3.eye, t);
+    target = catmullRom(k0.target, k1.target, k2.target, k3.target, t);
+    up     = normalize(catmullRom(k0.up, k1.up, k2.up, k3.up, t));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// reset per-segment statistics before a replay
+///////////////////////////////////////////////////////////////////////////////
+void CameraPath::beginPlayback()
+{
+    SegmentStats empty = { 0, 0, 0, 0 };
+    stats.assign(keys.size() > 1 ? keys.size() - 1 : 0, empty);
+    lastSegment = -1;
+    lastFrame = Clock::now();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// called once per replayed frame with the path time of the frame
+// The real time since the previous call is the duration of the previous
+// frame, so it is added to the segment of the previous frame.
+///////////////////////////////////////////////////////////////////////////////
+void CameraPath::addFrame(float time)
+{
+    Clock::time_point now = Clock::now();
+    double frameTime = std::chrono::duration<double>(now - lastFrame).count();
+    lastFrame = now;
+
+    if(lastSegment >= 0 && lastSegment < (int)stats.size())
+    {
+        SegmentStats& s = stats[lastSegment];
+        if(s.frames == 0 || frameTime < s.min)
+            s.min = frameTime;
+        if(frameTime > s.max)
+            s.max = frameTime;
+        s.total += frameTime;
+        ++s.frames;
+    }
+    lastSegment = getSegment(time);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print frame time statistics of each segment and the whole path in ms
+///////////////////////////////////////////////////////////////////////////////
+void CameraPath::printStats(std::ostream& os) const
+{
+    SegmentStats all = { 0, 0, 0, 0 };
+    os << "segment     time   frames   mean(ms)    min(ms)    max(ms)\n";
+    os << std::fixed;
+    for(size_t i = 0; i < stats.size(); ++i)
+    {
+        const SegmentStats& s = stats[i];
+        os << std::setw(7) << i << std::setw(9) << std::setprecision(2) << keys[i].time
+           << std::setw(9) << s.frames << std::setprecision(3)
+           << std::setw(11) << s.mean() * 1000
+           << std::setw(11) << s.min * 1000
+           << std::setw(11) << s.max * 1000 << '\n';
+
+        if(s.frames == 0)
+            continue;
+        if(all.frames == 0 || s.min < all.min)
+            all.min = s.min;
+        if(s.max > all.max)
+            all.max = s.max;
+        all.total += s.total;
+        all.frames += s.frames;
+    }
+    os << "  total" << std::setw(9) << std::setprecision(2) << getDuration()
+       << std::setw(9) << all.frames << std::setprecision(3)
+       << std::setw(11) << all.mean() * 1000
+       << std::setw(11) << all.min * 1000
+       << std::setw(11) << all.max * 1000 << std::endl;
+    os.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////
+// CameraPath.h
+// ============
+// camera flight path recorded as keyframes and replayed along a spline
+//
+// A path is a list of keyframes (time, eye, target, up) sampled while the
+// user flies the camera. It is saved as a text file, one keyframe per line,
+// so the same flight can be replayed by any build or renderer.
+// The playback evaluates a Catmull-Rom spline through the keyframes at the
+// simulated time, which the caller advances by a fixed step per frame. Thus a
+// replay shows exactly the same views regardless of the frame rate.
+// While playing, the real time between frames is accumulated per segment
+// (the interval between 2 keyframes), giving frame time statistics for each
+// part of the flight.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <chrono>
+#include "VectorMath.h"
+
+class CameraPath
+{
+public:
+    struct Key
+    {
+        float time;                                 // seconds from the start of path
+        Vec3 eye;
+        Vec3 target;
+        Vec3 up;
+    };
+
+    struct SegmentStats
+    {
+        int frames;
+        double total;                               // sum of frame times in seconds
+        double min;
+        double max;
+        double mean() const                         { return frames ? total / frames : 0; }
+    };
+
+    CameraPath();
+    ~CameraPath();
+
+    // recording
+    void clear();
+    void addKey(float time, const Vec3& eye, const Vec3& target, const Vec3& up);
+    bool save(const std::string& fileName) const;
+    bool load(const std::string& fileName);
+
+    // playback
+    void evaluate(float time, Vec3& eye, Vec3& target, Vec3& up) const;
+    void beginPlayback();                           // reset statistics and frame timer
+    void addFrame(float time);                      // measure real time since last frame, time: path time of the frame
+    void printStats(std::ostream& os) const;
+
+    int getKeyCount() const                         { return (int)keys.size(); }
+    float getDuration() const                       { return keys.empty() ? 0 : keys.back().time; }
+    int getSegment(float time) const;               // index of segment containing time
+    const std::vector<SegmentStats>& getStats() const { return stats; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    std::vector<Key> keys;                          // sorted by time
+    std::vector<SegmentStats> stats;                // per segment, keys.size()-1 entries
+    Clock::time_point lastFrame;
+    int lastSegment;                                // segment of the previous frame, -1 before first frame
+};
+
+#endif
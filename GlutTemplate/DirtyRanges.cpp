@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// DirtyRanges.cpp
+// ===============
+// set of modified record ranges for partial buffer uploads
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include "DirtyRanges.h"
+
+static bool compareFirst(const DirtyRanges::Range& a, const DirtyRanges::Range& b)
+{
+    return a.first < b.first;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+DirtyRanges::DirtyRanges(int gapThreshold) : gapThreshold(gapThreshold), sorted(true)
+{
+}
+DirtyRanges::~DirtyRanges()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// mark records dirty
+// Records are usually marked in increasing order, so extend the last range
+// right away if possible to keep the list short.
+///////////////////////////////////////////////////////////////////////////////
+void DirtyRanges::add(int first, int count)
+{
+    if(count <= 0)
+        return;
+
+    if(!ranges.empty())
+    {
+        Range& last = ranges.back();
+        int lastEnd = last.first + last.count;
+        if(first >= last.first && first <= lastEnd + gapThreshold)
+        {
+            if(first + count > lastEnd)
+                last.count = first + count - last.first;
+            return;
+        }
+        if(first < last.first)
+            sorted = false;
+    }
+
+    Range range = { first, count };
+    ranges.push_back(range);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all ranges
+///////////////////////////////////////////////////////////////////////////////
+void DirtyRanges::clear()
+{
+    ranges.clear();
+    sorted = true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check if a record is dirty (binary search on coalesced ranges)
+///////////////////////////////////////////////////////////////////////////////
+bool DirtyRanges::contains(int index)
+{
+    coalesce();
+
+    Range key = { index, 0 };
+    std::vector<Range>::const_iterator iter = std::upper_bound(ranges.begin(), ranges.end(), key, compareFirst);
+    if(iter == ranges.begin())
+        return false;
+    --iter;
+    return index < iter->first + iter->count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sort ranges and merge the ranges overlapping or closer than gap threshold
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<DirtyRanges::Range>& DirtyRanges::coalesce()
+{
+    if(sorted || ranges.size() < 2)
+    {
+        sorted = true;
+        return ranges;
+    }
+
+    std::sort(ranges.begin(), ranges.end(), compareFirst);
+
+    size_t last = 0;
+    for(size_t i = 1; i < ranges.size(); ++i)
+    {
+        int lastEnd = ranges[last].first + ranges[last].count;
+        if(ranges[i].first <= lastEnd + gapThreshold)
+        {
+            int end = ranges[i].first + ranges[i].count;
+            if(end > lastEnd)
+                ranges[last].count = end - ranges[last].first;
+        }
+        else
+        {
+            ranges[++last] = ranges[i];
+        }
+    }
+    ranges.resize(last + 1);
+    sorted = true;
+    return ranges;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the number of records to be transferred
+///////////////////////////////////////////////////////////////////////////////
+int DirtyRanges::getRecordCount()
+{
+    coalesce();
+
+    int count = 0;
+    for(size_t i = 0; i < ranges.size(); ++i)
+        count += ranges[i].count;
+    return count;
+}
@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////
+// DirtyRanges.h
+// =============
+// set of modified record ranges for partial buffer uploads
+//
+// Ranges are added in any order. coalesce() sorts them and merges the ranges
+// separated by no more than gapThreshold clean records, because one larger
+// transfer is cheaper than many small ones when the gap is small. Larger gap
+// means fewer transfer calls but more redundant bytes.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DIRTY_RANGES_H
+#define DIRTY_RANGES_H
+
+#include <vector>
+
+class DirtyRanges
+{
+public:
+    struct Range
+    {
+        int first;
+        int count;
+    };
+
+    DirtyRanges(int gapThreshold=16);
+    ~DirtyRanges();
+
+    void add(int first, int count=1);               // mark records dirty
+    void clear();
+    bool empty() const                              { return ranges.empty(); }
+    bool contains(int index);
+
+    const std::vector<Range>& coalesce();           // sort and merge, return the result
+    const std::vector<Range>& getRanges() const     { return ranges; }  // as added, may be unsorted
+    int getRecordCount();                           // number of records covered by coalesced ranges
+
+    void setGapThreshold(int gap)                   { gapThreshold = gap < 0 ? 0 : gap; sorted = false; }
+    int getGapThreshold() const                     { return gapThreshold; }
+
+private:
+    std::vector<Range> ranges;
+    int gapThreshold;                               // max clean records between merged ranges
+    bool sorted;                                    // true if ranges are already coalesced
+};
+
+#endif
@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+// FramePacer.cpp
+// ==============
+// paces the redraws of the GLUT idle callback
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include "FramePacer.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <OpenGL/OpenGL.h>
+#else
+#include <GL/glx.h>
+#include <EGL/egl.h>
+#endif
+
+namespace
+{
+    const double MIN_SPIN_MARGIN = 0.0002;          // seconds
+    const double MAX_SPIN_MARGIN = 0.004;
+    const double SPIN_MARGIN_DECAY = 0.99;          // per sleep, after an oversleep raised it
+    const int MAX_DIVISOR = 4;                      // adaptive rate goes down to 1/4 of target
+    const int ADAPT_WINDOW = 30;                    // frames in which ADAPT_MISSES lower the rate
+    const int ADAPT_MISSES = 3;
+    const int ADAPT_RECOVER = 120;                  // fast frames in a row to raise the rate again
+    const double FAST_FRACTION = 0.75;              // of the faster period, for a frame to count as fast
+
+    double toSeconds(std::chrono::steady_clock::duration d)
+    {
+        return std::chrono::duration<double>(d).count();
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+FramePacer::FramePacer(double targetRate) : mode(MODE_UNLIMITED), targetRate(targetRate), divisor(1),
+                                            redrawRequested(true), frameStarted(false), spinMargin(0.001),
+                                            missedFrames(0), skippedFrames(0), recentMisses(0),
+                                            windowFrames(0), fastFrames(0)
+{
+}
+FramePacer::~FramePacer()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the swap interval for the mode and restart the schedule
+///////////////////////////////////////////////////////////////////////////////
+bool FramePacer::setMode(Mode mode)
+{
+    bool vsync = mode == MODE_VSYNC;
+    bool ok = setSwapInterval(vsync ? 1 : 0);
+    if(!ok && vsync)
+    {
+        std::cout << "[FramePacer::setMode()] Swap interval is not supported, pacing to the target rate." << std::endl;
+        mode = MODE_TARGET;
+    }
+
+    this->mode = mode;
+    divisor = 1;
+    recentMisses = windowFrames = fastFrames = 0;
+    deadline = lastFrameEnd = Clock::time_point();
+    redrawRequested = true;
+    return ok || !vsync;
+}
+
+void FramePacer::setTargetRate(double rate)
+{
+    if(rate > 0)
+        targetRate = rate;
+    divisor = 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// wait for the start of the next frame
+// Return false if the scene is idle and nothing asked for a redraw.
+///////////////////////////////////////////////////////////////////////////////
+bool FramePacer::waitNextFrame(bool sceneIdle)
+{
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(divisor / targetRate));
+    if(sceneIdle && !redrawRequested)
+    {
+        // nothing changes, look again after a period without spinning
+        std::this_thread::sleep_for(period);
+        ++skippedFrames;
+        lastFrameEnd = Clock::time_point();
+        return false;
+    }
+    redrawRequested = false;
+    frameStarted = true;
+
+    if(mode == MODE_TARGET || mode == MODE_ADAPTIVE)
+    {
+        // this frame starts at the deadline of the last one; a frame late by a
+        // whole period or more restarts the schedule instead of catching up
+        Clock::time_point now = Clock::now();
+        Clock::time_point start = deadline;
+        if(start > now)
+            sleepUntil(start);
+        else if(now - start >= period)
+            start = now;
+        deadline = start + period;
+    }
+    frameStart = Clock::now();
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count a missed deadline, and adapt the rate
+///////////////////////////////////////////////////////////////////////////////
+void FramePacer::endFrame()
+{
+    Clock::time_point now = Clock::now();
+    bool missed = false;
+    if(mode == MODE_VSYNC)
+    {
+        // frames without an idle skip in between come one refresh apart
+        if(lastFrameEnd != Clock::time_point())
+            missed = toSeconds(now - lastFrameEnd) > 1.5 / targetRate;
+        lastFrameEnd = now;
+    }
+    else if(frameStarted && (mode == MODE_TARGET || mode == MODE_ADAPTIVE))
+    {
+        missed = now > deadline;
+    }
+
+    if(missed)
+        ++missedFrames;
+    if(mode == MODE_ADAPTIVE && frameStarted)
+        adapt(missed, toSeconds(now - frameStart));
+    frameStarted = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// lower the rate after several misses in a window of frames, raise it after
+// many frames in a row which would fit in the faster period with headroom
+///////////////////////////////////////////////////////////////////////////////
+void FramePacer::adapt(bool missed, double workSeconds)
+{
+    ++windowFrames;
+    if(missed)
+        ++recentMisses;
+
+    if(recentMisses >= ADAPT_MISSES && divisor < MAX_DIVISOR)
+    {
+        ++divisor;
+        recentMisses = windowFrames = fastFrames = 0;
+        return;
+    }
+    if(windowFrames >= ADAPT_WINDOW)
+        recentMisses = windowFrames = 0;
+
+    if(divisor > 1 && workSeconds < FAST_FRACTION * (divisor - 1) / targetRate)
+        ++fastFrames;
+    else
+        fastFrames = 0;
+    if(fastFrames >= ADAPT_RECOVER)
+    {
+        --divisor;
+        recentMisses = windowFrames = fastFrames = 0;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sleep until spinMargin before the deadline, then spin
+// The margin follows the latest oversleep of the OS and decays slowly.
+///////////////////////////////////////////////////////////////////////////////
+void FramePacer::sleepUntil(Clock::time_point deadline)
+{
+    Clock::time_point wake = deadline - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(spinMargin));
+    if(Clock::now() < wake)
+    {
+        std::this_thread::sleep_until(wake);
+        double late = toSeconds(Clock::now() - wake);
+        spinMargin = std::max(spinMargin * SPIN_MARGIN_DECAY, late * 1.25);
+        spinMargin = std::min(std::max(spinMargin, MIN_SPIN_MARGIN), MAX_SPIN_MARGIN);
+    }
+
+    while(Clock::now() < deadline)
+        std::this_thread::yield();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the swap interval of the current context, 0 to swap immediately
+///////////////////////////////////////////////////////////////////////////////
+bool FramePacer::setSwapInterval(int interval)
+{
+#ifdef _WIN32
+    typedef BOOL (WINAPI *SwapIntervalProc)(int);
+    SwapIntervalProc swapInterval = (SwapIntervalProc)wglGetProcAddress("wglSwapIntervalEXT");
+    return swapInterval && swapInterval(interval);
+#elif defined(__APPLE__)
+    GLint value = interval;
+    CGLContextObj context = CGLGetCurrentContext();
+    return context && CGLSetParameter(context, kCGLCPSwapInterval, &value) == kCGLNoError;
+#else
+    // a headless EGL context, or a GLX window of GLUT
+    if(eglGetCurrentContext() != EGL_NO_CONTEXT)
+        return eglSwapInterval(eglGetCurrentDisplay(), interval) == EGL_TRUE;
+
+    Display* display = glXGetCurrentDisplay();
+    GLXDrawable drawable = glXGetCurrentDrawable();
+    if(!display || !drawable)
+        return false;
+
+    const char* extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+    if(!extensions)
+        return false;
+    if(strstr(extensions, "GLX_EXT_swap_control"))
+    {
+        typedef void (*SwapIntervalEXTProc)(Display*, GLXDrawable, int);
+        SwapIntervalEXTProc swapInterval = (SwapIntervalEXTProc)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalEXT");
+        if(swapInterval)
+        {
+            swapInterval(display, drawable, interval);
+            return true;
+        }
+    }
+    if(strstr(extensions, "GLX_MESA_swap_control"))
+    {
+        typedef int (*SwapIntervalMESAProc)(unsigned int);
+        SwapIntervalMESAProc swapInterval = (SwapIntervalMESAProc)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalMESA");
+        if(swapInterval)
+            return swapInterval(interval) == 0;
+    }
+    if(strstr(extensions, "GLX_SGI_swap_control") && interval > 0)     // SGI cannot turn vsync off
+    {
+        typedef int (*SwapIntervalSGIProc)(int);
+        SwapIntervalSGIProc swapInterval = (SwapIntervalSGIProc)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalSGI");
+        if(swapInterval)
+            return swapInterval(interval) == 0;
+    }
+    return false;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// name of a mode, for the HUD and the command line
+///////////////////////////////////////////////////////////////////////////////
+const char* FramePacer::getModeName(Mode mode)
+{
+    static const char* const NAMES[MODE_COUNT] = { "unlimited", "target", "vsync", "adaptive" };
+    return mode >= 0 && mode < MODE_COUNT ? NAMES[mode] : "unknown";
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// FramePacer.h
+// ============
+// paces the redraws of the GLUT idle callback instead of redrawing as fast
+// as possible
+//
+// Modes:
+// MODE_UNLIMITED: no waiting and no vsync, the old busy loop for measuring
+// MODE_TARGET:    sleeps until the next deadline at the target rate
+// MODE_VSYNC:     swap interval 1, glutSwapBuffers() waits for the display
+// MODE_ADAPTIVE:  like MODE_TARGET, but the rate drops to 1/2, 1/3 or 1/4 of
+//                 the target while frames keep missing their deadlines, and
+//                 comes back once they finish well within the faster period
+// Waiting sleeps until a margin before the deadline and spins the rest, since
+// the OS may wake the thread late. The margin follows the latest oversleep.
+// A frame which finishes after its deadline (or, with vsync, after 1.5
+// periods of the target rate, which should be the refresh rate) is counted as
+// missed; the schedule then restarts from the current time instead of
+// rushing to catch up.
+// If the caller reports the scene as idle and no redraw was requested (input,
+// resize), waitNextFrame() sleeps for a period and returns false, so nothing
+// is drawn and the CPU is not busy.
+// The swap interval is set through GLX, EGL, WGL or CGL for the current
+// context, so setMode() must be called after the window is created.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+
+class FramePacer
+{
+public:
+    enum Mode { MODE_UNLIMITED, MODE_TARGET, MODE_VSYNC, MODE_ADAPTIVE, MODE_COUNT };
+
+    FramePacer(double targetRate=60);
+    ~FramePacer();
+
+    bool setMode(Mode mode);                        // false if vsync is not supported, MODE_TARGET is used then
+    Mode getMode() const                            { return mode; }
+    void setTargetRate(double rate);                // frames per second
+    double getTargetRate() const                    { return targetRate; }
+    double getRate() const                          { return targetRate / divisor; }   // after adaptive drops
+
+    void requestRedraw()                            { redrawRequested = true; }
+    bool waitNextFrame(bool sceneIdle);             // call in idleCB(), false to skip the redraw
+    void endFrame();                                // call after swapping buffers
+
+    int getMissedFrames() const                     { return missedFrames; }
+    int getSkippedFrames() const                    { return skippedFrames; }
+    double getSpinMargin() const                    { return spinMargin * 1000; }  // ms
+
+    static const char* getModeName(Mode mode);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void sleepUntil(Clock::time_point deadline);
+    void adapt(bool missed, double workSeconds);
+    static bool setSwapInterval(int interval);
+
+    Mode mode;
+    double targetRate;
+    int divisor;                                    // frame period is divisor / targetRate
+    bool redrawRequested;
+    bool frameStarted;                              // waitNextFrame() returned true, endFrame() not called yet
+    Clock::time_point deadline;                     // end of current frame period
+    Clock::time_point frameStart;                   // wake-up time of current frame
+    Clock::time_point lastFrameEnd;                 // for vsync, zero after a skipped frame
+    double spinMargin;                              // seconds spun before a deadline
+    int missedFrames;
+    int skippedFrames;
+    int recentMisses;                               // adaptive: misses in the current window
+    int windowFrames;                               // adaptive: frames in the current window
+    int fastFrames;                                 // adaptive: frames in a row fast enough for the faster rate
+};
+
+#endif
@@ -0,0 +1,284 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameStats.cpp
+// ==============
+// per-frame CPU/GPU time history with percentiles and spike detection
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+#include "FrameStats.h"
+
+const int MIN_SPIKE_FRAMES = 32;                    // frames needed before a median is trusted
+const int MAX_SPIKE_LOG    = 8;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+FrameStats::FrameStats(int capacity) : frames(capacity > 0 ? capacity : 1), spikeFactor(2.0f),
+                                       spikeLogging(true)
+{
+    reset();
+}
+FrameStats::~FrameStats()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return steady clock time in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+long long FrameStats::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// clear history, keep phase and pass names
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::reset()
+{
+    head = count = 0;
+    frameNumber = 0;
+    frameStart = lastMark = lastFrameEnd = 0;
+    spikeCount = 0;
+    spikeLog.clear();
+    for(int i = 0; i < MAX_PHASES; ++i)
+    {
+        phaseNs[i] = 0;
+        gpuPassMeans[i] = 0;
+    }
+    for(int i = 0; i < CHANNEL_COUNT; ++i)
+    {
+        Summary empty = { 0, 0, 0, 0, 0, 0 };
+        summaries[i] = empty;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// register a named phase of the frame
+///////////////////////////////////////////////////////////////////////////////
+int FrameStats::addPhase(const char* name)
+{
+    if((int)phaseNames.size() >= MAX_PHASES)
+        return -1;
+    phaseNames.push_back(name);
+    return (int)phaseNames.size() - 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// register a named GPU pass, the index of its time in setGpuTimes()
+///////////////////////////////////////////////////////////////////////////////
+int FrameStats::addGpuPass(const char* name)
+{
+    if((int)gpuPassNames.size() >= MAX_PHASES)
+        return -1;
+    gpuPassNames.push_back(name);
+    return (int)gpuPassNames.size() - 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start timing a frame
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::beginFrame()
+{
+    frameStart = lastMark = now();
+    for(int i = 0; i < MAX_PHASES; ++i)
+        phaseNs[i] = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the time since the previous mark (beginFrame() or endPhase()) belongs to
+// the phase; a phase may end several times in a frame
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::endPhase(int phase)
+{
+    long long t = now();
+    if(phase >= 0 && phase < MAX_PHASES)
+        phaseNs[phase] += t - lastMark;
+    lastMark = t;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// store the finished frame in ring buffer
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::endFrame()
+{
+    long long t = now();
+
+    Frame& f = frames[head];
+    f.number = frameNumber;
+    f.cpuNs = t - frameStart;
+    f.frameNs = lastFrameEnd ? t - lastFrameEnd : f.cpuNs;
+    f.gpuNs = -1;
+    for(int i = 0; i < MAX_PHASES; ++i)
+    {
+        f.phaseNs[i] = phaseNs[i];
+        f.gpuPassNs[i] = -1;
+    }
+    lastFrameEnd = t;
+
+    head = (head + 1) % (int)frames.size();
+    if(count < (int)frames.size())
+        ++count;
+    ++frameNumber;
+
+    if(frameNumber % SUMMARY_INTERVAL == 0)
+        updateSummaries();
+    checkSpike(f);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// attach GPU pass times to a finished frame; ignored if it is already
+// overwritten. The GPU time of the frame is the sum of the measured passes.
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::setGpuTimes(unsigned long number, const long long* passNs)
+{
+    if(number >= frameNumber)
+        return;
+
+    unsigned long age = frameNumber - 1 - number;
+    if(age >= (unsigned long)count)
+        return;
+
+    int size = (int)frames.size();
+    Frame& f = frames[(head - 1 - (int)age + size) % size];
+    if(f.number != number)
+        return;
+
+    f.gpuNs = -1;
+    for(int i = 0; i < (int)gpuPassNames.size(); ++i)
+    {
+        f.gpuPassNs[i] = passNs[i];
+        if(passNs[i] >= 0)
+            f.gpuNs = (f.gpuNs < 0 ? 0 : f.gpuNs) + passNs[i];
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return a finished frame, 0 is the latest
+///////////////////////////////////////////////////////////////////////////////
+const FrameStats::Frame& FrameStats::getFrame(int age) const
+{
+    int size = (int)frames.size();
+    int index = ((head - 1 - age) % size + size) % size;
+    return frames[index];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// recompute mean, percentiles and max of each channel, and the mean of each
+// GPU pass over the ring buffer
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::updateSummaries()
+{
+    for(int c = 0; c < CHANNEL_COUNT; ++c)
+    {
+        scratch.clear();
+        for(int i = 0; i < count; ++i)
+        {
+            const Frame& f = frames[i];
+            long long ns = c == FRAME ? f.frameNs : (c == CPU ? f.cpuNs : f.gpuNs);
+            if(ns >= 0)
+                scratch.push_back(ns);
+        }
+
+        summaries[c] = summarize(scratch);
+    }
+
+    for(int p = 0; p < (int)gpuPassNames.size(); ++p)
+    {
+        long long total = 0;
+        int n = 0;
+        for(int i = 0; i < count; ++i)
+        {
+            if(frames[i].gpuPassNs[p] >= 0)
+            {
+                total += frames[i].gpuPassNs[p];
+                ++n;
+            }
+        }
+        gpuPassMeans[p] = n > 0 ? total * 1e-6 / n : 0;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute mean, percentiles and max of times in ns, the result is in ms
+// Percentiles use the nearest-rank method; the input is sorted in place.
+///////////////////////////////////////////////////////////////////////////////
+FrameStats::Summary FrameStats::summarize(std::vector<long long>& ns)
+{
+    Summary s = { (int)ns.size(), 0, 0, 0, 0, 0 };
+    if(ns.empty())
+        return s;
+
+    std::sort(ns.begin(), ns.end());
+    long long total = 0;
+    for(size_t i = 0; i < ns.size(); ++i)
+        total += ns[i];
+
+    int n = (int)ns.size();
+    s.mean = total * 1e-6 / n;
+    s.p50 = ns[(n * 50 + 99) / 100 - 1] * 1e-6;
+    s.p95 = ns[(n * 95 + 99) / 100 - 1] * 1e-6;
+    s.p99 = ns[(n * 99 + 99) / 100 - 1] * 1e-6;
+    s.max = ns[n - 1] * 1e-6;
+    return s;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// log the frame if it took much longer than the median
+///////////////////////////////////////////////////////////////////////////////
+void FrameStats::checkSpike(const Frame& frame)
+{
+    const Summary& s = summaries[FRAME];
+    if(s.count < MIN_SPIKE_FRAMES || frame.frameNs * 1e-6 <= s.p50 * spikeFactor)
+        return;
+
+    ++spikeCount;
+
+    char buffer[256];
+    int length = snprintf(buffer, sizeof(buffer), "spike frame %lu: %.2f ms (median %.2f, cpu %.2f)",
+                          frame.number, frame.frameNs * 1e-6, s.p50, frame.cpuNs * 1e-6);
+    for(size_t i = 0; i < phaseNames.size() && length < (int)sizeof(buffer); ++i)
+        length += snprintf(buffer + length, sizeof(buffer) - length, "%s%s %.2f", i == 0 ? " [" : ", ",
+                           phaseNames[i].c_str(), frame.phaseNs[i] * 1e-6);
+    if(!phaseNames.empty() && length < (int)sizeof(buffer))
+        snprintf(buffer + length, sizeof(buffer) - length, "]");
+
+    if(spikeLog.size() >= (size_t)MAX_SPIKE_LOG)
+        spikeLog.erase(spikeLog.begin());
+    spikeLog.push_back(buffer);
+
+    if(spikeLogging)
+        std::cout << "[FrameStats] " << buffer << std::endl;
+}
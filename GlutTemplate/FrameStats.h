@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameStats.h
+// ============
+// per-frame CPU/GPU time history with percentiles and spike detection
+//
+// The times are measured with a monotonic nanosecond clock. Each frame keeps
+// the interval since the previous frame, the CPU time spent from beginFrame()
+// to endFrame() split into named phases, and the GPU time of named passes,
+// which arrives a few frames later from timer queries through setGpuTimes().
+// The last N frames are kept in a ring buffer. The percentiles (p50, p95,
+// p99) and max are recomputed every SUMMARY_INTERVAL frames, not per call,
+// so reading them every frame for the HUD is cheap.
+// A frame longer than spikeFactor times the median is a spike; it is printed
+// with its phase breakdown and kept in a short log. When frames are skipped
+// on purpose, restartInterval() keeps the idle time out of the next interval.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <vector>
+#include <string>
+
+class FrameStats
+{
+public:
+    static const int MAX_PHASES = 8;
+    static const int SUMMARY_INTERVAL = 16;         // frames between percentile updates
+
+    enum Channel { FRAME, CPU, GPU, CHANNEL_COUNT };
+
+    struct Frame
+    {
+        unsigned long number;
+        long long frameNs;                          // interval since end of previous frame
+        long long cpuNs;                            // beginFrame() to endFrame()
+        long long gpuNs;                            // sum of GPU passes, -1 until reported
+        long long phaseNs[MAX_PHASES];
+        long long gpuPassNs[MAX_PHASES];            // -1 if not measured
+    };
+
+    struct Summary                                  // in milliseconds
+    {
+        int count;
+        double mean;
+        double p50;
+        double p95;
+        double p99;
+        double max;
+    };
+
+    FrameStats(int capacity=600);
+    ~FrameStats();
+
+    static long long now();                         // monotonic clock in nanoseconds
+    static Summary summarize(std::vector<long long>& ns);   // sorts ns, result in ms
+
+    int  addPhase(const char* name);                // return phase index, -1 if full
+    int  addGpuPass(const char* name);              // return pass index, -1 if full
+    void beginFrame();
+    void endPhase(int phase);                       // add time since last mark to phase
+    void endFrame();
+    void setGpuTimes(unsigned long frameNumber, const long long* passNs);   // ns per pass, -1 if not measured
+    void reset();
+    void restartInterval()                          { lastFrameEnd = 0; }   // next frame interval is its CPU time
+
+    void setSpikeFactor(float factor)               { spikeFactor = factor; }
+    void setSpikeLogging(bool flag)                 { spikeLogging = flag; }
+
+    unsigned long getFrameNumber() const            { return frameNumber; }   // number of frame in progress
+    int  getCount() const                           { return count; }
+    int  getCapacity() const                        { return (int)frames.size(); }
+    const Frame& getFrame(int age) const;           // 0: latest finished frame
+    const Summary& getSummary(Channel channel) const { return summaries[channel]; }
+    int  getPhaseCount() const                      { return (int)phaseNames.size(); }
+    const char* getPhaseName(int phase) const       { return phaseNames[phase].c_str(); }
+    int  getGpuPassCount() const                    { return (int)gpuPassNames.size(); }
+    const char* getGpuPassName(int pass) const      { return gpuPassNames[pass].c_str(); }
+    double getGpuPassMean(int pass) const           { return gpuPassMeans[pass]; }     // ms
+    int  getSpikeCount() const                      { return spikeCount; }
+    const std::vector<std::string>& getSpikeLog() const { return spikeLog; }
+
+private:
+    void updateSummaries();
+    void checkSpike(const Frame& frame);
+
+    std::vector<Frame> frames;                      // ring buffer
+    std::vector<std::string> phaseNames;
+    std::vector<std::string> gpuPassNames;
+    std::vector<long long> scratch;                 // sorted copy for percentiles
+    Summary summaries[CHANNEL_COUNT];
+    double gpuPassMeans[MAX_PHASES];
+    int head;                                       // next slot to write
+    int count;
+    unsigned long frameNumber;
+    long long frameStart;
+    long long lastMark;
+    long long lastFrameEnd;
+    long long phaseNs[MAX_PHASES];                  // phases of frame in progress
+    float spikeFactor;
+    bool spikeLogging;
+    int spikeCount;
+    std::vector<std::string> spikeLog;              // latest spikes, oldest first
+};
+
+#endif
@@ -0,0 +1,475 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlCallCounter.cpp
+// =================
+// counts GL calls per entry point, binds and state changes of each frame
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#define GL_CALL_COUNTER_NO_REDIRECT             // the wrappers call the real entry points
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include "GlCallCounter.h"
+
+namespace
+{
+    struct Counts
+    {
+        int calls;
+        int binds;
+        int redundantBinds;
+        int stateChanges;
+        int redundantStateChanges;
+        int entryCalls[GlCallCounter::MAX_ENTRY_POINTS];
+        int entryRedundant[GlCallCounter::MAX_ENTRY_POINTS];
+    };
+
+    Counts current;                                 // frame being drawn
+    Counts last;                                    // last finished frame
+    const char* names[GlCallCounter::MAX_ENTRY_POINTS];
+    int nameCount = 0;
+
+    bool higherCalls(const GlCallCounter::Entry& a, const GlCallCounter::Entry& b)
+    {
+        return a.calls > b.calls;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// true if the GL entry points are redirected to the counters
+///////////////////////////////////////////////////////////////////////////////
+bool GlCallCounter::isEnabled()
+{
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the slot of an entry point, called once per call site
+// If all slots are taken, the calls are counted in the last one.
+///////////////////////////////////////////////////////////////////////////////
+int GlCallCounter::getId(const char* name)
+{
+    for(int i = 0; i < nameCount; ++i)
+    {
+        if(strcmp(names[i], name) == 0)
+            return i;
+    }
+    if(nameCount == MAX_ENTRY_POINTS)
+    {
+        names[MAX_ENTRY_POINTS - 1] = "other";
+        return MAX_ENTRY_POINTS - 1;
+    }
+    names[nameCount] = name;
+    return nameCount++;
+}
+
+const char* GlCallCounter::getName(int id)
+{
+    return (id >= 0 && id < nameCount) ? names[id] : "";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count a call of the entry point
+///////////////////////////////////////////////////////////////////////////////
+void GlCallCounter::count(int id)
+{
+    ++current.calls;
+    ++current.entryCalls[id];
+}
+
+void GlCallCounter::countBind(int id, bool redundant)
+{
+    count(id);
+    ++current.binds;
+    if(redundant)
+    {
+        ++current.redundantBinds;
+        ++current.entryRedundant[id];
+    }
+}
+
+void GlCallCounter::countState(int id, bool redundant)
+{
+    count(id);
+    ++current.stateChanges;
+    if(redundant)
+    {
+        ++current.redundantStateChanges;
+        ++current.entryRedundant[id];
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// keep the counts of the finished frame, and start counting the next one
+///////////////////////////////////////////////////////////////////////////////
+void GlCallCounter::endFrame()
+{
+    last = current;
+    memset(&current, 0, sizeof(current));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters for the last frame
+///////////////////////////////////////////////////////////////////////////////
+int GlCallCounter::getCalls()                   { return last.calls; }
+int GlCallCounter::getBinds()                   { return last.binds; }
+int GlCallCounter::getRedundantBinds()          { return last.redundantBinds; }
+int GlCallCounter::getStateChanges()            { return last.stateChanges; }
+int GlCallCounter::getRedundantStateChanges()   { return last.redundantStateChanges; }
+
+int GlCallCounter::getTopEntries(Entry* entries, int maxCount)
+{
+    std::vector<Entry> all;
+    for(int i = 0; i < nameCount; ++i)
+    {
+        if(last.entryCalls[i] > 0)
+        {
+            Entry e = { names[i], last.entryCalls[i], last.entryRedundant[i] };
+            all.push_back(e);
+        }
+    }
+    std::stable_sort(all.begin(), all.end(), higherCalls);
+
+    int count = std::min(maxCount, (int)all.size());
+    for(int i = 0; i < count; ++i)
+        entries[i] = all[i];
+    return count;
+}
+
+
+
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+///////////////////////////////////////////////////////////////////////////////
+// shadow copy of the state set through the wrappers
+// A key is the kind of state in the top 8 bits and the target, capability,
+// index etc. below it. A state not in the list is unknown, so the first call
+// setting it is never redundant.
+///////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    enum StateKind
+    {
+        STATE_BUFFER = 1, STATE_TEXTURE, STATE_PROGRAM, STATE_FRAMEBUFFER, STATE_RENDERBUFFER,
+        STATE_VERTEX_ARRAY, STATE_ACTIVE_TEXTURE, STATE_ENABLE, STATE_CLIENT_STATE,
+        STATE_ATTRIB_ARRAY, STATE_BLEND_FUNC, STATE_DEPTH_MASK, STATE_POLYGON_MODE
+    };
+
+    struct State
+    {
+        unsigned int key;
+        unsigned int value;
+    };
+
+    // a plain array, not destroyed at exit before the destructors of global
+    // objects which still call GL, e.g. HeadlessContext
+    const int MAX_STATES = 256;
+    State shadow[MAX_STATES];
+    int shadowCount = 0;
+    GLenum activeTexture = GL_TEXTURE0;             // for the texture binding keys
+
+    unsigned int makeKey(StateKind kind, unsigned int target)
+    {
+        return ((unsigned int)kind << 24) | (target & 0xffffff);
+    }
+
+    // store the value, return true if it was set already
+    bool update(StateKind kind, unsigned int target, unsigned int value)
+    {
+        unsigned int key = makeKey(kind, target);
+        for(int i = 0; i < shadowCount; ++i)
+        {
+            if(shadow[i].key == key)
+            {
+                bool same = shadow[i].value == value;
+                shadow[i].value = value;
+                return same;
+            }
+        }
+        if(shadowCount < MAX_STATES)
+        {
+            State s = { key, value };
+            shadow[shadowCount++] = s;
+        }
+        return false;
+    }
+
+    // the state changed without going through the wrappers
+    void forget()
+    {
+        shadowCount = 0;
+        activeTexture = GL_TEXTURE0;
+    }
+
+    // texture bindings are per texture unit
+    unsigned int textureTarget(GLenum target)
+    {
+        return ((activeTexture - GL_TEXTURE0) << 16) | (target & 0xffff);
+    }
+}
+
+#define COUNTER_ID(name) static const int id = GlCallCounter::getId(name)
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// binds
+///////////////////////////////////////////////////////////////////////////////
+void countedBindBuffer(GLenum target, GLuint buffer)
+{
+    COUNTER_ID("glBindBuffer");
+    GlCallCounter::countBind(id, update(STATE_BUFFER, target, buffer));
+    GlCapture::writeCall(id, target, buffer);
+    glBindBuffer(target, buffer);
+}
+
+void countedBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    // binds the generic target too; the indexed binding is not tracked
+    COUNTER_ID("glBindBufferBase");
+    GlCallCounter::countBind(id, false);
+    update(STATE_BUFFER, target, buffer);
+    GlCapture::writeCall(id, target, index, buffer);
+    glBindBufferBase(target, index, buffer);
+}
+
+void countedBindTexture(GLenum target, GLuint texture)
+{
+    COUNTER_ID("glBindTexture");
+    GlCallCounter::countBind(id, update(STATE_TEXTURE, textureTarget(target), texture));
+    GlCapture::writeCall(id, target, texture);
+    glBindTexture(target, texture);
+}
+
+void countedUseProgram(GLuint program)
+{
+    COUNTER_ID("glUseProgram");
+    GlCallCounter::countBind(id, update(STATE_PROGRAM, 0, program));
+    GlCapture::writeCall(id, program);
+    glUseProgram(program);
+}
+
+void countedBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    COUNTER_ID("glBindFramebuffer");
+    bool redundant;
+    if(target == GL_FRAMEBUFFER)
+    {
+        bool draw = update(STATE_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER, framebuffer);
+        bool read = update(STATE_FRAMEBUFFER, GL_READ_FRAMEBUFFER, framebuffer);
+        redundant = draw && read;
+    }
+    else
+    {
+        redundant = update(STATE_FRAMEBUFFER, target, framebuffer);
+    }
+    GlCallCounter::countBind(id, redundant);
+    GlCapture::writeCall(id, target, framebuffer);
+    glBindFramebuffer(target, framebuffer);
+}
+
+void countedBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    COUNTER_ID("glBindRenderbuffer");
+    GlCallCounter::countBind(id, update(STATE_RENDERBUFFER, target, renderbuffer));
+    GlCapture::writeCall(id, target, renderbuffer);
+    glBindRenderbuffer(target, renderbuffer);
+}
+
+void countedBindVertexArray(GLuint array)
+{
+    COUNTER_ID("glBindVertexArray");
+    GlCallCounter::countBind(id, update(STATE_VERTEX_ARRAY, 0, array));
+    GlCapture::writeCall(id, array);
+    glBindVertexArray(array);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// state changes
+///////////////////////////////////////////////////////////////////////////////
+void countedActiveTexture(GLenum texture)
+{
+    COUNTER_ID("glActiveTexture");
+    GlCallCounter::countState(id, update(STATE_ACTIVE_TEXTURE, 0, texture));
+    activeTexture = texture;
+    GlCapture::writeCall(id, texture);
+    glActiveTexture(texture);
+}
+
+void countedEnable(GLenum cap)
+{
+    COUNTER_ID("glEnable");
+    GlCallCounter::countState(id, update(STATE_ENABLE, cap, 1));
+    GlCapture::writeCall(id, cap);
+    glEnable(cap);
+}
+
+void countedDisable(GLenum cap)
+{
+    COUNTER_ID("glDisable");
+    GlCallCounter::countState(id, update(STATE_ENABLE, cap, 0));
+    GlCapture::writeCall(id, cap);
+    glDisable(cap);
+}
+
+void countedEnableClientState(GLenum array)
+{
+    COUNTER_ID("glEnableClientState");
+    GlCallCounter::countState(id, update(STATE_CLIENT_STATE, array, 1));
+    GlCapture::writeCall(id, array);
+    glEnableClientState(array);
+}
+
+void countedDisableClientState(GLenum array)
+{
+    COUNTER_ID("glDisableClientState");
+    GlCallCounter::countState(id, update(STATE_CLIENT_STATE, array, 0));
+    GlCapture::writeCall(id, array);
+    glDisableClientState(array);
+}
+
+void countedEnableVertexAttribArray(GLuint index)
+{
+    COUNTER_ID("glEnableVertexAttribArray");
+    GlCallCounter::countState(id, update(STATE_ATTRIB_ARRAY, index, 1));
+    GlCapture::writeCall(id, index);
+    glEnableVertexAttribArray(index);
+}
+
+void countedDisableVertexAttribArray(GLuint index)
+{
+    COUNTER_ID("glDisableVertexAttribArray");
+    GlCallCounter::countState(id, update(STATE_ATTRIB_ARRAY, index, 0));
+    GlCapture::writeCall(id, index);
+    glDisableVertexAttribArray(index);
+}
+
+void countedBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    COUNTER_ID("glBlendFunc");
+    GlCallCounter::countState(id, update(STATE_BLEND_FUNC, 0, (sfactor << 16) | (dfactor & 0xffff)));
+    GlCapture::writeCall(id, sfactor, dfactor);
+    glBlendFunc(sfactor, dfactor);
+}
+
+void countedDepthMask(GLboolean flag)
+{
+    COUNTER_ID("glDepthMask");
+    GlCallCounter::countState(id, update(STATE_DEPTH_MASK, 0, flag));
+    GlCapture::writeCall(id, flag);
+    glDepthMask(flag);
+}
+
+void countedPolygonMode(GLenum face, GLenum mode)
+{
+    COUNTER_ID("glPolygonMode");
+    bool redundant;
+    if(face == GL_FRONT_AND_BACK)
+    {
+        bool front = update(STATE_POLYGON_MODE, GL_FRONT, mode);
+        bool back = update(STATE_POLYGON_MODE, GL_BACK, mode);
+        redundant = front && back;
+    }
+    else
+    {
+        redundant = update(STATE_POLYGON_MODE, face, mode);
+    }
+    GlCallCounter::countState(id, redundant);
+    GlCapture::writeCall(id, face, mode);
+    glPolygonMode(face, mode);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// calls changing state behind the shadow copy
+///////////////////////////////////////////////////////////////////////////////
+void countedPopAttrib()
+{
+    COUNTER_ID("glPopAttrib");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeCall(id);
+    glPopAttrib();
+}
+
+void countedPopClientAttrib()
+{
+    COUNTER_ID("glPopClientAttrib");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeCall(id);
+    glPopClientAttrib();
+}
+
+void countedDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    COUNTER_ID("glDeleteBuffers");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeNames(id, n, buffers);
+    glDeleteBuffers(n, buffers);
+}
+
+void countedDeleteTextures(GLsizei n, const GLuint* textures)
+{
+    COUNTER_ID("glDeleteTextures");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeNames(id, n, textures);
+    glDeleteTextures(n, textures);
+}
+
+void countedDeleteProgram(GLuint program)
+{
+    COUNTER_ID("glDeleteProgram");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeCall(id, program);
+    glDeleteProgram(program);
+}
+
+void countedDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    COUNTER_ID("glDeleteFramebuffers");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeNames(id, n, framebuffers);
+    glDeleteFramebuffers(n, framebuffers);
+}
+
+void countedDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+    COUNTER_ID("glDeleteRenderbuffers");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeNames(id, n, renderbuffers);
+    glDeleteRenderbuffers(n, renderbuffers);
+}
+
+void countedDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+    COUNTER_ID("glDeleteVertexArrays");
+    GlCallCounter::count(id);
+    forget();
+    GlCapture::writeNames(id, n, arrays);
+    glDeleteVertexArrays(n, arrays);
+}
+#endif
@@ -0,0 +1,253 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlCallCounter.h
+// ===============
+// counts GL calls per entry point, binds and state changes of each frame
+//
+// It is an optional interception layer for Linux (any non-Windows build).
+// Built with -DGL_CALL_COUNTING, glExtension.h includes this file at its end
+// and the macros below route the GL entry points used by this program to
+// counters, the same way the Windows build routes extension entry points to
+// pgl* pointers. Without the flag nothing is redirected, and isEnabled()
+// returns false.
+// Most entry points are only counted: the macro makes a GlCall object, which
+// bumps the counter of the entry point, writes the arguments if GlCapture is
+// capturing, then calls the original function. Binds (glBindBuffer,
+// glBindTexture, glUseProgram, ...) and state changes (glEnable, glBlendFunc,
+// ...) go through wrapper functions that compare with a shadow copy of the
+// state, to count redundant calls setting the value already set.
+// glPopAttrib(), glPopClientAttrib() and glDelete*() change state behind the
+// shadow copy, so they clear it; the next call of each state is then not
+// counted as redundant.
+// The calls passing memory to GL go through the recording wrappers of
+// GlCapture.h, which count them too.
+// Counting is for the render thread only and takes no lock. endFrame() makes
+// the counts of the current frame available to the getters.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GL_CALL_COUNTER_H
+#define GL_CALL_COUNTER_H
+
+#include "glExtension.h"
+
+class GlCallCounter
+{
+public:
+    static const int MAX_ENTRY_POINTS = 256;
+
+    struct Entry
+    {
+        const char* name;
+        int calls;
+        int redundant;                              // binds/state changes to the current value
+    };
+
+    static bool isEnabled();                        // built with GL_CALL_COUNTING
+    static int  getId(const char* name);            // slot of an entry point, added on first use
+    static const char* getName(int id);
+    static void count(int id);
+    static void countBind(int id, bool redundant);  // count(id) is called by the wrapper too
+    static void countState(int id, bool redundant);
+    static void endFrame();
+
+    // counts of the last finished frame
+    static int getCalls();
+    static int getBinds();
+    static int getRedundantBinds();
+    static int getStateChanges();
+    static int getRedundantStateChanges();
+    static int getTopEntries(Entry* entries, int maxCount);     // by calls, return count
+};
+
+
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+// wrappers tracking bind and state redundancy
+void countedBindBuffer(GLenum target, GLuint buffer);
+void countedBindBufferBase(GLenum target, GLuint index, GLuint buffer);
+void countedBindTexture(GLenum target, GLuint texture);
+void countedUseProgram(GLuint program);
+void countedBindFramebuffer(GLenum target, GLuint framebuffer);
+void countedBindRenderbuffer(GLenum target, GLuint renderbuffer);
+void countedBindVertexArray(GLuint array);
+void countedActiveTexture(GLenum texture);
+void countedEnable(GLenum cap);
+void countedDisable(GLenum cap);
+void countedEnableClientState(GLenum array);
+void countedDisableClientState(GLenum array);
+void countedEnableVertexAttribArray(GLuint index);
+void countedDisableVertexAttribArray(GLuint index);
+void countedBlendFunc(GLenum sfactor, GLenum dfactor);
+void countedDepthMask(GLboolean flag);
+void countedPolygonMode(GLenum face, GLenum mode);
+
+// wrappers clearing the shadow state
+void countedPopAttrib();
+void countedPopClientAttrib();
+void countedDeleteBuffers(GLsizei n, const GLuint* buffers);
+void countedDeleteTextures(GLsizei n, const GLuint* textures);
+void countedDeleteProgram(GLuint program);
+void countedDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void countedDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void countedDeleteVertexArrays(GLsizei n, const GLuint* arrays);
+
+#include "GlCapture.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// counts and captures a call, then calls the original entry point
+///////////////////////////////////////////////////////////////////////////////
+template<typename F> class GlCall;
+
+template<typename R, typename... Args>
+class GlCall<R (*)(Args...)>
+{
+public:
+    GlCall(int id, R (*function)(Args...)) : id(id), function(function) {}
+
+    R operator()(Args... args) const
+    {
+        GlCallCounter::count(id);
+        GlCapture::writeCall(id, args...);
+        return function(args...);
+    }
+
+private:
+    int id;
+    R (*function)(Args...);
+};
+
+#ifndef GL_CALL_COUNTER_NO_REDIRECT
+// a macro is not expanded again inside its own expansion, so the name in
+// GL_COUNTED() refers to the real function; the id is looked up once per call site
+#define GL_COUNTED(name) GlCall<decltype(&name)>([]() { static const int id = GlCallCounter::getId(#name); return id; }(), &name)
+
+#define glBindBuffer                    countedBindBuffer
+#define glBindBufferBase                countedBindBufferBase
+#define glBindTexture                   countedBindTexture
+#define glUseProgram                    countedUseProgram
+#define glBindFramebuffer               countedBindFramebuffer
+#define glBindRenderbuffer              countedBindRenderbuffer
+#define glBindVertexArray               countedBindVertexArray
+#define glActiveTexture                 countedActiveTexture
+#define glEnable                        countedEnable
+#define glDisable                       countedDisable
+#define glEnableClientState             countedEnableClientState
+#define glDisableClientState            countedDisableClientState
+#define glEnableVertexAttribArray       countedEnableVertexAttribArray
+#define glDisableVertexAttribArray      countedDisableVertexAttribArray
+#define glBlendFunc                     countedBlendFunc
+#define glDepthMask                     countedDepthMask
+#define glPolygonMode                   countedPolygonMode
+#define glPopAttrib                     countedPopAttrib
+#define glPopClientAttrib               countedPopClientAttrib
+#define glDeleteBuffers                 countedDeleteBuffers
+#define glDeleteTextures                countedDeleteTextures
+#define glDeleteProgram                 countedDeleteProgram
+#define glDeleteFramebuffers            countedDeleteFramebuffers
+#define glDeleteRenderbuffers           countedDeleteRenderbuffers
+#define glDeleteVertexArrays            countedDeleteVertexArrays
+
+// calls passing memory or creating objects, see GlCapture.h
+#define glBufferData                    recordedBufferData
+#define glBufferSubData                 recordedBufferSubData
+#define glMapBufferRange                recordedMapBufferRange
+#define glFlushMappedBufferRange        recordedFlushMappedBufferRange
+#define glUnmapBuffer                   recordedUnmapBuffer
+#define glShaderSource                  recordedShaderSource
+#define glTransformFeedbackVaryings     recordedTransformFeedbackVaryings
+#define glGetUniformLocation            recordedGetUniformLocation
+#define glGetAttribLocation             recordedGetAttribLocation
+#define glUniform3fv                    recordedUniform3fv
+#define glUniformMatrix4fv              recordedUniformMatrix4fv
+#define glLightfv                       recordedLightfv
+#define glLoadMatrixf                   recordedLoadMatrixf
+#define glMultMatrixf                   recordedMultMatrixf
+#define glTexImage2D                    recordedTexImage2D
+#define glGenBuffers                    recordedGenBuffers
+#define glGenTextures                   recordedGenTextures
+#define glGenFramebuffers               recordedGenFramebuffers
+#define glGenRenderbuffers              recordedGenRenderbuffers
+#define glGenQueries                    recordedGenQueries
+#define glDeleteQueries                 recordedDeleteQueries
+#define glCreateShader                  recordedCreateShader
+#define glCreateProgram                 recordedCreateProgram
+
+// draw calls
+#define glDrawArrays                    GL_COUNTED(glDrawArrays)
+#define glDrawArraysInstanced           GL_COUNTED(glDrawArraysInstanced)
+#define glDrawElements                  GL_COUNTED(glDrawElements)
+#define glDrawElementsInstanced         GL_COUNTED(glDrawElementsInstanced)
+#define glClear                         GL_COUNTED(glClear)
+#define glBeginTransformFeedback        GL_COUNTED(glBeginTransformFeedback)
+#define glEndTransformFeedback          GL_COUNTED(glEndTransformFeedback)
+
+// buffer data
+#define glCopyBufferSubData             GL_COUNTED(glCopyBufferSubData)
+#define glGetBufferParameteriv          GL_COUNTED(glGetBufferParameteriv)
+
+// vertex arrays
+#define glVertexPointer                 GL_COUNTED(glVertexPointer)
+#define glNormalPointer                 GL_COUNTED(glNormalPointer)
+#define glColorPointer                  GL_COUNTED(glColorPointer)
+#define glTexCoordPointer               GL_COUNTED(glTexCoordPointer)
+#define glVertexAttribPointer           GL_COUNTED(glVertexAttribPointer)
+#define glVertexAttribDivisor           GL_COUNTED(glVertexAttribDivisor)
+
+// shaders and uniforms
+#define glCompileShader                 GL_COUNTED(glCompileShader)
+#define glDeleteShader                  GL_COUNTED(glDeleteShader)
+#define glAttachShader                  GL_COUNTED(glAttachShader)
+#define glLinkProgram                   GL_COUNTED(glLinkProgram)
+#define glGetShaderiv                   GL_COUNTED(glGetShaderiv)
+#define glGetShaderInfoLog              GL_COUNTED(glGetShaderInfoLog)
+#define glGetProgramiv                  GL_COUNTED(glGetProgramiv)
+#define glGetProgramInfoLog             GL_COUNTED(glGetProgramInfoLog)
+#define glUniform1i                     GL_COUNTED(glUniform1i)
+#define glUniform1f                     GL_COUNTED(glUniform1f)
+#define glUniform2f                     GL_COUNTED(glUniform2f)
+
+// textures, framebuffers and queries
+#define glTexParameteri                 GL_COUNTED(glTexParameteri)
+#define glTexEnvi                       GL_COUNTED(glTexEnvi)
+#define glPixelStorei                   GL_COUNTED(glPixelStorei)
+#define glRenderbufferStorage           GL_COUNTED(glRenderbufferStorage)
+#define glFramebufferRenderbuffer       GL_COUNTED(glFramebufferRenderbuffer)
+#define glCheckFramebufferStatus        GL_COUNTED(glCheckFramebufferStatus)
+#define glDrawBuffer                    GL_COUNTED(glDrawBuffer)
+#define glReadBuffer                    GL_COUNTED(glReadBuffer)
+#define glReadPixels                    GL_COUNTED(glReadPixels)
+#define glBeginQuery                    GL_COUNTED(glBeginQuery)
+#define glEndQuery                      GL_COUNTED(glEndQuery)
+#define glGetQueryObjectiv              GL_COUNTED(glGetQueryObjectiv)
+#define glGetQueryObjectui64v           GL_COUNTED(glGetQueryObjectui64v)
+
+// fixed-function state and matrices
+#define glMatrixMode                    GL_COUNTED(glMatrixMode)
+#define glLoadIdentity                  GL_COUNTED(glLoadIdentity)
+#define glPushMatrix                    GL_COUNTED(glPushMatrix)
+#define glPopMatrix                     GL_COUNTED(glPopMatrix)
+#define glRotatef                       GL_COUNTED(glRotatef)
+#define glOrtho                         GL_COUNTED(glOrtho)
+#define glViewport                      GL_COUNTED(glViewport)
+#define glPushAttrib                    GL_COUNTED(glPushAttrib)
+#define glPushClientAttrib              GL_COUNTED(glPushClientAttrib)
+#define glColorMaterial                 GL_COUNTED(glColorMaterial)
+#define glShadeModel                    GL_COUNTED(glShadeModel)
+#define glHint                          GL_COUNTED(glHint)
+#define glDepthFunc                     GL_COUNTED(glDepthFunc)
+#define glClearColor                    GL_COUNTED(glClearColor)
+#define glClearDepth                    GL_COUNTED(glClearDepth)
+#define glClearStencil                  GL_COUNTED(glClearStencil)
+
+// queries and synchronization
+#define glGetString                     GL_COUNTED(glGetString)
+#define glGetIntegerv                   GL_COUNTED(glGetIntegerv)
+#define glGetError                      GL_COUNTED(glGetError)
+#define glFlush                         GL_COUNTED(glFlush)
+#define glFinish                        GL_COUNTED(glFinish)
+#endif
+
+#endif
+
+#endif
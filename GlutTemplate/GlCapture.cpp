@@ -0,0 +1,607 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlCapture.cpp
+// =============
+// records the GL command stream to a binary file for GlReplay
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#define GL_CALL_COUNTER_NO_REDIRECT             // the wrappers call the real entry points
+#include <iostream>
+#include <cstring>
+#include "GlCapture.h"
+#include "GlCallCounter.h"
+
+const char GlCapture::MAGIC[8] = { 'G', 'L', 'C', 'A', 'P', 'T', 'R', 0 };
+bool GlCapture::capturing = false;
+FILE* GlCapture::file = 0;
+std::vector<char> GlCapture::buffer;
+size_t GlCapture::callStart = 0;
+std::vector<bool> GlCapture::defined;
+int GlCapture::framesLeft = 0;
+int GlCapture::frameCount = 0;
+long long GlCapture::bytesWritten = 0;
+
+namespace
+{
+    const size_t FLUSH_SIZE = 4 << 20;              // write buffered records to file at this size
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// open the file and capture the calls of the next frames
+///////////////////////////////////////////////////////////////////////////////
+bool GlCapture::start(const std::string& fileName, int frames, int width, int height)
+{
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+    stop();
+    file = fopen(fileName.c_str(), "wb");
+    if(!file)
+    {
+        std::cout << "[GlCapture::start()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    buffer.clear();
+    defined.assign(GlCallCounter::MAX_ENTRY_POINTS, false);
+    writeBytes(MAGIC, sizeof(MAGIC));
+    unsigned int header[3] = { VERSION, (unsigned int)width, (unsigned int)height };
+    writeBytes(header, sizeof(header));
+
+    framesLeft = frames;
+    frameCount = 0;
+    bytesWritten = 0;
+    capturing = true;
+    std::cout << "Capturing GL calls of " << frames << " frames to " << fileName << std::endl;
+    return true;
+#else
+    std::cout << "[GlCapture::start()] GL capture needs a build with -DGL_CALL_COUNTING on Linux." << std::endl;
+    return false;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the remaining records and close the file
+///////////////////////////////////////////////////////////////////////////////
+void GlCapture::stop()
+{
+    if(!file)
+        return;
+
+    capturing = false;
+    flush();
+    fclose(file);
+    file = 0;
+    std::cout << "Captured " << frameCount << " frames, " << bytesWritten / 1024 << " KB." << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// mark the end of initialization; it is not counted as a frame
+///////////////////////////////////////////////////////////////////////////////
+void GlCapture::endSetup()
+{
+    if(capturing)
+        writeMarker();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// mark the end of a frame, and stop after the last requested frame
+///////////////////////////////////////////////////////////////////////////////
+void GlCapture::endFrame()
+{
+    if(!capturing)
+        return;
+
+    writeMarker();
+    ++frameCount;
+    if(--framesLeft <= 0)
+        stop();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start a call record; its size is filled in by endCall()
+// The first call of an entry point also writes its name.
+///////////////////////////////////////////////////////////////////////////////
+void GlCapture::beginCall(int id)
+{
+    if(!defined[id])
+    {
+        const char* name = GlCallCounter::getName(id);
+        unsigned short code = DEFINE_RECORD;
+        unsigned short shortId = (unsigned short)id;
+        unsigned int size = (unsigned int)(sizeof(shortId) + strlen(name));
+        writeBytes(&code, sizeof(code));
+        writeBytes(&size, sizeof(size));
+        writeBytes(&shortId, sizeof(shortId));
+        writeBytes(name, strlen(name));
+        defined[id] = true;
+    }
+
+    unsigned short code = (unsigned short)id;
+    unsigned int size = 0;
+    callStart = buffer.size();
+    writeBytes(&code, sizeof(code));
+    writeBytes(&size, sizeof(size));
+}
+
+void GlCapture::endCall()
+{
+    unsigned int size = (unsigned int)(buffer.size() - callStart - sizeof(unsigned short) - sizeof(unsigned int));
+    memcpy(&buffer[callStart + sizeof(unsigned short)], &size, sizeof(size));
+    if(buffer.size() >= FLUSH_SIZE)
+        flush();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// arguments
+///////////////////////////////////////////////////////////////////////////////
+void GlCapture::write(int value)                    { writeBytes(&value, 4); }
+void GlCapture::write(unsigned int value)           { writeBytes(&value, 4); }
+void GlCapture::write(float value)                  { writeBytes(&value, 4); }
+void GlCapture::write(double value)                 { writeBytes(&value, 8); }
+void GlCapture::write(unsigned char value)          { writeBytes(&value, 1); }
+void GlCapture::write(long value)                   { long long v = value; writeBytes(&v, 8); }
+void GlCapture::write(unsigned long value)          { unsigned long long v = value; writeBytes(&v, 8); }
+void GlCapture::write(long long value)              { writeBytes(&value, 8); }
+void GlCapture::write(unsigned long long value)     { writeBytes(&value, 8); }
+
+void GlCapture::write(const void* pointer)
+{
+    unsigned long long offset = (unsigned long long)(size_t)pointer;
+    writeBytes(&offset, 8);
+}
+
+void GlCapture::writeMemory(const void* data, size_t size)
+{
+    unsigned int size32 = data ? (unsigned int)size : 0;
+    writeBytes(&size32, sizeof(size32));
+    if(size32 > 0)
+        writeBytes(data, size32);
+}
+
+void GlCapture::writeNames(int id, GLsizei n, const GLuint* names)
+{
+    if(!capturing)
+        return;
+    beginCall(id);
+    write(n);
+    writeMemory(names, n * sizeof(GLuint));
+    endCall();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append to the record buffer
+///////////////////////////////////////////////////////////////////////////////
+void GlCapture::writeMarker()
+{
+    unsigned short code = FRAME_RECORD;
+    unsigned int size = 0;
+    writeBytes(&code, sizeof(code));
+    writeBytes(&size, sizeof(size));
+}
+
+void GlCapture::writeBytes(const void* data, size_t size)
+{
+    const char* bytes = (const char*)data;
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void GlCapture::flush()
+{
+    if(file && !buffer.empty())
+    {
+        fwrite(&buffer[0], 1, buffer.size(), file);
+        bytesWritten += buffer.size();
+    }
+    buffer.clear();
+}
+
+
+
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+#define COUNTER_ID(name) static const int id = GlCallCounter::getId(name)
+
+namespace
+{
+    // the buffer mapped by glMapBufferRange() per target
+    struct Mapping
+    {
+        GLenum target;
+        char* pointer;
+        GLsizeiptr length;
+        GLbitfield access;
+    };
+    std::vector<Mapping> mappings;
+
+    Mapping* findMapping(GLenum target)
+    {
+        for(size_t i = 0; i < mappings.size(); ++i)
+        {
+            if(mappings[i].target == target)
+                return &mappings[i];
+        }
+        return 0;
+    }
+
+    // bytes of an image passed to glTexImage2D(), with the unpack row alignment
+    size_t getImageSize(GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        int components = 4;
+        if(format == GL_ALPHA || format == GL_LUMINANCE || format == GL_RED || format == GL_DEPTH_COMPONENT)
+            components = 1;
+        else if(format == GL_LUMINANCE_ALPHA || format == GL_RG)
+            components = 2;
+        else if(format == GL_RGB || format == GL_BGR)
+            components = 3;
+
+        int bytes = 1;
+        if(type == GL_FLOAT || type == GL_INT || type == GL_UNSIGNED_INT)
+            bytes = 4;
+        else if(type == GL_SHORT || type == GL_UNSIGNED_SHORT || type == GL_HALF_FLOAT)
+            bytes = 2;
+
+        GLint alignment = 4;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+        size_t row = (size_t)width * components * bytes;
+        row = (row + alignment - 1) / alignment * alignment;
+        return row * height;
+    }
+
+    // number of floats of a glLightfv() parameter
+    int getLightParamCount(GLenum pname)
+    {
+        if(pname == GL_AMBIENT || pname == GL_DIFFUSE || pname == GL_SPECULAR || pname == GL_POSITION)
+            return 4;
+        if(pname == GL_SPOT_DIRECTION)
+            return 3;
+        return 1;
+    }
+
+    // a list of strings, e.g. shader sources; each as memory including the NUL
+    void writeStrings(GLsizei count, const GLchar* const* strings, const GLint* lengths)
+    {
+        GlCapture::write(count);
+        for(GLsizei i = 0; i < count; ++i)
+        {
+            std::string str = (lengths && lengths[i] >= 0) ? std::string(strings[i], lengths[i]) : std::string(strings[i]);
+            GlCapture::writeMemory(str.c_str(), str.size() + 1);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// calls passing memory
+///////////////////////////////////////////////////////////////////////////////
+void recordedBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    COUNTER_ID("glBufferData");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(target);
+        GlCapture::write(size);
+        GlCapture::writeMemory(data, size);
+        GlCapture::write(usage);
+        GlCapture::endCall();
+    }
+    glBufferData(target, size, data, usage);
+}
+
+void recordedBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    COUNTER_ID("glBufferSubData");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(target);
+        GlCapture::write(offset);
+        GlCapture::writeMemory(data, size);
+        GlCapture::endCall();
+    }
+    glBufferSubData(target, offset, size, data);
+}
+
+void* recordedMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    COUNTER_ID("glMapBufferRange");
+    GlCallCounter::count(id);
+    GlCapture::writeCall(id, target, offset, length, access);
+    void* pointer = glMapBufferRange(target, offset, length, access);
+
+    // the data written to the mapping is captured at flush or unmap
+    Mapping* m = findMapping(target);
+    if(!m)
+    {
+        mappings.push_back(Mapping());
+        m = &mappings.back();
+    }
+    m->target = target;
+    m->pointer = (char*)pointer;
+    m->length = pointer ? length : 0;
+    m->access = access;
+    return pointer;
+}
+
+void recordedFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    COUNTER_ID("glFlushMappedBufferRange");
+    GlCallCounter::count(id);
+    Mapping* m = findMapping(target);
+    if(GlCapture::isCapturing() && m && m->pointer && offset + length <= m->length)
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(target);
+        GlCapture::write(offset);
+        GlCapture::writeMemory(m->pointer + offset, length);
+        GlCapture::endCall();
+    }
+    glFlushMappedBufferRange(target, offset, length);
+}
+
+GLboolean recordedUnmapBuffer(GLenum target)
+{
+    COUNTER_ID("glUnmapBuffer");
+    GlCallCounter::count(id);
+    Mapping* m = findMapping(target);
+    if(GlCapture::isCapturing())
+    {
+        // without explicit flushes, the whole written range is flushed now
+        GlCapture::beginCall(id);
+        GlCapture::write(target);
+        if(m && m->pointer && (m->access & GL_MAP_WRITE_BIT) && !(m->access & GL_MAP_FLUSH_EXPLICIT_BIT))
+            GlCapture::writeMemory(m->pointer, m->length);
+        else
+            GlCapture::writeMemory(0, 0);
+        GlCapture::endCall();
+    }
+    if(m)
+        m->pointer = 0;
+    return glUnmapBuffer(target);
+}
+
+void recordedShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+{
+    COUNTER_ID("glShaderSource");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(shader);
+        writeStrings(count, strings, lengths);
+        GlCapture::endCall();
+    }
+    glShaderSource(shader, count, strings, lengths);
+}
+
+void recordedTransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar* const* varyings, GLenum bufferMode)
+{
+    COUNTER_ID("glTransformFeedbackVaryings");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(program);
+        writeStrings(count, varyings, 0);
+        GlCapture::write(bufferMode);
+        GlCapture::endCall();
+    }
+    glTransformFeedbackVaryings(program, count, varyings, bufferMode);
+}
+
+// the location is written after the name, so the replay can map its own to it
+GLint recordedGetUniformLocation(GLuint program, const GLchar* name)
+{
+    COUNTER_ID("glGetUniformLocation");
+    GlCallCounter::count(id);
+    GLint location = glGetUniformLocation(program, name);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(program);
+        GlCapture::writeMemory(name, strlen(name) + 1);
+        GlCapture::write(location);
+        GlCapture::endCall();
+    }
+    return location;
+}
+
+GLint recordedGetAttribLocation(GLuint program, const GLchar* name)
+{
+    COUNTER_ID("glGetAttribLocation");
+    GlCallCounter::count(id);
+    GLint location = glGetAttribLocation(program, name);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(program);
+        GlCapture::writeMemory(name, strlen(name) + 1);
+        GlCapture::write(location);
+        GlCapture::endCall();
+    }
+    return location;
+}
+
+void recordedUniform3fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    COUNTER_ID("glUniform3fv");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(location);
+        GlCapture::write(count);
+        GlCapture::writeMemory(value, count * 3 * sizeof(GLfloat));
+        GlCapture::endCall();
+    }
+    glUniform3fv(location, count, value);
+}
+
+void recordedUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    COUNTER_ID("glUniformMatrix4fv");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(location);
+        GlCapture::write(count);
+        GlCapture::write(transpose);
+        GlCapture::writeMemory(value, count * 16 * sizeof(GLfloat));
+        GlCapture::endCall();
+    }
+    glUniformMatrix4fv(location, count, transpose, value);
+}
+
+void recordedLightfv(GLenum light, GLenum pname, const GLfloat* params)
+{
+    COUNTER_ID("glLightfv");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(light);
+        GlCapture::write(pname);
+        GlCapture::writeMemory(params, getLightParamCount(pname) * sizeof(GLfloat));
+        GlCapture::endCall();
+    }
+    glLightfv(light, pname, params);
+}
+
+void recordedLoadMatrixf(const GLfloat* m)
+{
+    COUNTER_ID("glLoadMatrixf");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::writeMemory(m, 16 * sizeof(GLfloat));
+        GlCapture::endCall();
+    }
+    glLoadMatrixf(m);
+}
+
+void recordedMultMatrixf(const GLfloat* m)
+{
+    COUNTER_ID("glMultMatrixf");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::writeMemory(m, 16 * sizeof(GLfloat));
+        GlCapture::endCall();
+    }
+    glMultMatrixf(m);
+}
+
+// pixels from a bound pixel unpack buffer are not captured
+void recordedTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                        GLint border, GLenum format, GLenum type, const void* pixels)
+{
+    COUNTER_ID("glTexImage2D");
+    GlCallCounter::count(id);
+    if(GlCapture::isCapturing())
+    {
+        GlCapture::beginCall(id);
+        GlCapture::write(target);
+        GlCapture::write(level);
+        GlCapture::write(internalFormat);
+        GlCapture::write(width);
+        GlCapture::write(height);
+        GlCapture::write(border);
+        GlCapture::write(format);
+        GlCapture::write(type);
+        GlCapture::writeMemory(pixels, pixels ? getImageSize(width, height, format, type) : 0);
+        GlCapture::endCall();
+    }
+    glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// calls creating objects, written after the call with the new names
+///////////////////////////////////////////////////////////////////////////////
+void recordedGenBuffers(GLsizei n, GLuint* buffers)
+{
+    COUNTER_ID("glGenBuffers");
+    GlCallCounter::count(id);
+    glGenBuffers(n, buffers);
+    GlCapture::writeNames(id, n, buffers);
+}
+
+void recordedGenTextures(GLsizei n, GLuint* textures)
+{
+    COUNTER_ID("glGenTextures");
+    GlCallCounter::count(id);
+    glGenTextures(n, textures);
+    GlCapture::writeNames(id, n, textures);
+}
+
+void recordedGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    COUNTER_ID("glGenFramebuffers");
+    GlCallCounter::count(id);
+    glGenFramebuffers(n, framebuffers);
+    GlCapture::writeNames(id, n, framebuffers);
+}
+
+void recordedGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    COUNTER_ID("glGenRenderbuffers");
+    GlCallCounter::count(id);
+    glGenRenderbuffers(n, renderbuffers);
+    GlCapture::writeNames(id, n, renderbuffers);
+}
+
+void recordedGenQueries(GLsizei n, GLuint* ids)
+{
+    COUNTER_ID("glGenQueries");
+    GlCallCounter::count(id);
+    glGenQueries(n, ids);
+    GlCapture::writeNames(id, n, ids);
+}
+
+void recordedDeleteQueries(GLsizei n, const GLuint* ids)
+{
+    COUNTER_ID("glDeleteQueries");
+    GlCallCounter::count(id);
+    GlCapture::writeNames(id, n, ids);
+    glDeleteQueries(n, ids);
+}
+
+GLuint recordedCreateShader(GLenum type)
+{
+    COUNTER_ID("glCreateShader");
+    GlCallCounter::count(id);
+    GLuint shader = glCreateShader(type);
+    GlCapture::writeCall(id, type, shader);
+    return shader;
+}
+
+GLuint recordedCreateProgram()
+{
+    COUNTER_ID("glCreateProgram");
+    GlCallCounter::count(id);
+    GLuint program = glCreateProgram();
+    GlCapture::writeCall(id, program);
+    return program;
+}
+#endif
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlCapture.h
+// ===========
+// records the GL command stream to a binary file for GlReplay
+//
+// Capture uses the interception layer of GlCallCounter.h, so it needs a build
+// with -DGL_CALL_COUNTING. Every redirected entry point writes its id and
+// arguments while capturing; the calls passing memory (buffer data, mapped
+// ranges, shader sources, matrices, textures, names of new objects) write the
+// memory too, so the stream does not depend on the process that wrote it.
+// start() must be called before the GL objects are created, right after the
+// context is made current; the replay recreates them from the stream.
+// endSetup() marks the end of initialization, so the replay runs the calls
+// before it once and times the frames after it. endFrame() marks the end of
+// a frame and stops after the requested frames.
+// Client-side vertex arrays are not captured: a pointer argument is written
+// as an offset into the bound buffer object.
+//
+// file format (native byte order)
+// ===============================
+// header:  "GLCAPTR\0", uint32 version, uint32 width, uint32 height
+// records: uint16 code, uint32 size, then size bytes
+//   code DEFINE_RECORD: uint16 id, then the entry point name
+//   code FRAME_RECORD:  end of setup (the first one) or of a frame, no data
+//   other codes:        a call of entry point with this id; the arguments in
+//                       order, 4 bytes for 32-bit types, 8 bytes for 64-bit
+//                       types and pointers, 1 byte for GLboolean, and memory
+//                       as uint32 size followed by the bytes
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+// outside of the include guard: with GL_CALL_COUNTING, glExtension.h includes
+// GlCallCounter.h, which needs this file complete before its macros
+#include "glExtension.h"
+
+#ifndef GL_CAPTURE_H
+#define GL_CAPTURE_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+class GlCapture
+{
+public:
+    static const char MAGIC[8];
+    static const unsigned int VERSION = 1;
+    static const unsigned short DEFINE_RECORD = 0xffff;
+    static const unsigned short FRAME_RECORD = 0xfffe;
+
+    static bool start(const std::string& fileName, int frames, int width, int height);
+    static void stop();
+    static void endSetup();                         // call after initGL() and creating objects
+    static void endFrame();                         // call at end of displayCB()
+    static bool isCapturing()                       { return capturing; }
+
+    // writing a call; used by the wrappers while capturing
+    static void beginCall(int id);
+    static void endCall();
+    static void write(int value);
+    static void write(unsigned int value);
+    static void write(float value);
+    static void write(double value);
+    static void write(unsigned char value);
+    static void write(long value);
+    static void write(unsigned long value);
+    static void write(long long value);
+    static void write(unsigned long long value);
+    static void write(const void* pointer);         // as offset, see above
+    static void writeMemory(const void* data, size_t size);
+    static void writeNames(int id, GLsizei n, const GLuint* names);    // call with count and names
+
+    template<typename... Args>
+    static void writeCall(int id, Args... args)
+    {
+        if(!capturing)
+            return;
+        beginCall(id);
+        int expand[] = { 0, (write(args), 0)... };  // in argument order
+        (void)expand;
+        endCall();
+    }
+
+private:
+    static void writeMarker();
+    static void writeBytes(const void* data, size_t size);
+    static void flush();
+
+    static bool capturing;
+    static FILE* file;
+    static std::vector<char> buffer;                // records not written to file yet
+    static size_t callStart;                        // offset of current record in buffer
+    static std::vector<bool> defined;               // ids with DEFINE_RECORD written
+    static int framesLeft;
+    static int frameCount;
+    static long long bytesWritten;
+};
+
+
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+// wrappers writing the memory passed to GL
+void recordedBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void recordedBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+void* recordedMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+void recordedFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length);
+GLboolean recordedUnmapBuffer(GLenum target);
+void recordedShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths);
+void recordedTransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar* const* varyings, GLenum bufferMode);
+GLint recordedGetUniformLocation(GLuint program, const GLchar* name);
+GLint recordedGetAttribLocation(GLuint program, const GLchar* name);
+void recordedUniform3fv(GLint location, GLsizei count, const GLfloat* value);
+void recordedUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+void recordedLightfv(GLenum light, GLenum pname, const GLfloat* params);
+void recordedLoadMatrixf(const GLfloat* m);
+void recordedMultMatrixf(const GLfloat* m);
+void recordedTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                        GLint border, GLenum format, GLenum type, const void* pixels);
+
+// wrappers writing the names of new objects, which the replay maps to its own
+void recordedGenBuffers(GLsizei n, GLuint* buffers);
+void recordedGenTextures(GLsizei n, GLuint* textures);
+void recordedGenFramebuffers(GLsizei n, GLuint* framebuffers);
+void recordedGenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void recordedGenQueries(GLsizei n, GLuint* ids);
+void recordedDeleteQueries(GLsizei n, const GLuint* ids);
+GLuint recordedCreateShader(GLenum type);
+GLuint recordedCreateProgram();
+#endif
+
+#endif
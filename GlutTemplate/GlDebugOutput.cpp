@@ -0,0 +1,272 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlDebugOutput.cpp
+// =================
+// collects the messages of GL_KHR_debug / GL_ARB_debug_output
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "GlDebugOutput.h"
+
+namespace
+{
+    const int MAX_MESSAGES = 256;                   // unique messages kept
+
+    bool moreFrequent(const GlDebugOutput::Message* a, const GlDebugOutput::Message* b)
+    {
+        return a->count > b->count;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+GlDebugOutput::GlDebugOutput() : totalCount(0), droppedCount(0), lastPerformance(-1), frameNumber(0),
+                                 initialized(false), debugContext(false), khr(false)
+{
+    memset(current, 0, sizeof(current));
+    memset(last, 0, sizeof(last));
+}
+GlDebugOutput::~GlDebugOutput()
+{
+    release();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// register the callback and enable all messages
+///////////////////////////////////////////////////////////////////////////////
+bool GlDebugOutput::init()
+{
+    glExtension& ext = glExtension::getInstance();
+    khr = ext.isSupported("GL_KHR_debug");
+    if(!khr && !ext.isSupported("GL_ARB_debug_output"))
+    {
+        std::cout << "[GlDebugOutput::init()] GL_KHR_debug and GL_ARB_debug_output are not supported." << std::endl;
+        return false;
+    }
+
+    GLint flags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    debugContext = (flags & GL_CONTEXT_FLAG_DEBUG_BIT) != 0;
+    if(!debugContext)
+        std::cout << "[WARNING] Not a debug context, the driver may not report messages." << std::endl;
+
+    // GL_DEBUG_OUTPUT is on by default in a debug context, but only KHR_debug
+    // has it; messages of low severity are off by default
+    // A driver with ARB_debug_output only may not export the core names, so
+    // the ARB entry points are used then.
+    if(khr)
+    {
+        glEnable(GL_DEBUG_OUTPUT);
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDebugMessageCallback(callback, this);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, 0, GL_TRUE);
+    }
+    else
+    {
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+        glDebugMessageCallbackARB(callback, this);
+        glDebugMessageControlARB(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, 0, GL_TRUE);
+    }
+
+    initialized = true;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unregister the callback, the collected messages are kept for the report
+///////////////////////////////////////////////////////////////////////////////
+void GlDebugOutput::release()
+{
+    if(!initialized)
+        return;
+
+    if(khr)
+        glDebugMessageCallback(0, 0);
+    else
+        glDebugMessageCallbackARB(0, 0);
+    initialized = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// keep the counts of the finished frame, and start counting the next one
+///////////////////////////////////////////////////////////////////////////////
+void GlDebugOutput::endFrame()
+{
+    memcpy(last, current, sizeof(last));
+    memset(current, 0, sizeof(current));
+    ++frameNumber;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters
+///////////////////////////////////////////////////////////////////////////////
+int GlDebugOutput::getFrameCount() const
+{
+    int count = 0;
+    for(int i = 0; i < KIND_COUNT; ++i)
+        count += last[i];
+    return count;
+}
+
+const GlDebugOutput::Message* GlDebugOutput::getLastPerformance() const
+{
+    return lastPerformance >= 0 ? &messages[lastPerformance] : 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// called by GL in the call raising the message
+///////////////////////////////////////////////////////////////////////////////
+void APIENTRY GlDebugOutput::callback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                      GLsizei length, const GLchar* message, const void* userParam)
+{
+    GlDebugOutput* self = (GlDebugOutput*)userParam;
+    if(!self || !message)
+        return;
+
+    std::string text = length >= 0 ? std::string(message, length) : std::string(message);
+    while(!text.empty() && (text[text.size() - 1] == '\n' || text[text.size() - 1] == ' '))
+        text.erase(text.size() - 1);
+    self->add(source, type, id, severity, text);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count a message, and print it the first time
+///////////////////////////////////////////////////////////////////////////////
+void GlDebugOutput::add(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& text)
+{
+    Kind kind = getKind(type);
+    ++current[kind];
+    ++totalCount;
+
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "%x:%x:%u:", source, type, id);
+    std::string key = prefix + text;
+
+    int i = -1;
+    std::map<std::string, int>::const_iterator it = index.find(key);
+    if(it != index.end())
+    {
+        i = it->second;
+    }
+    else if((int)messages.size() < MAX_MESSAGES)
+    {
+        Message m = { source, type, severity, id, text, 0, frameNumber, frameNumber };
+        messages.push_back(m);
+        i = (int)messages.size() - 1;
+        index[key] = i;
+        std::cout << "[GL " << getKindName(kind) << "] " << getSourceName(source) << ", "
+                  << getSeverityName(severity) << ": " << text << std::endl;
+    }
+    else
+    {
+        ++droppedCount;
+        return;
+    }
+
+    ++messages[i].count;
+    messages[i].lastFrame = frameNumber;
+    if(kind == KIND_PERFORMANCE)
+        lastPerformance = i;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print counts per kind and the unique messages, most frequent first
+///////////////////////////////////////////////////////////////////////////////
+void GlDebugOutput::printReport(std::ostream& os) const
+{
+    int counts[KIND_COUNT] = { 0 };
+    std::vector<const Message*> sorted;
+    for(size_t i = 0; i < messages.size(); ++i)
+    {
+        counts[getKind(messages[i].type)] += messages[i].count;
+        sorted.push_back(&messages[i]);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), moreFrequent);
+
+    os << "GL debug output: " << totalCount << " messages (" << messages.size() << " unique) in "
+       << frameNumber << " frames:";
+    for(int k = 0; k < KIND_COUNT; ++k)
+        os << " " << getKindName((Kind)k) << " " << counts[k] << (k + 1 < KIND_COUNT ? "," : "");
+    os << std::endl;
+
+    char line[128];
+    for(size_t i = 0; i < sorted.size(); ++i)
+    {
+        const Message& m = *sorted[i];
+        snprintf(line, sizeof(line), "%8d  %-11s %-15s %-12s frames %lu-%lu  ", m.count, getKindName(getKind(m.type)),
+                 getSourceName(m.source), getSeverityName(m.severity), m.firstFrame, m.lastFrame);
+        os << line << m.text << std::endl;
+    }
+    if(droppedCount > 0)
+        os << droppedCount << " messages not listed, more than " << MAX_MESSAGES << " unique messages." << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// names of the enums, for the HUD and the report
+///////////////////////////////////////////////////////////////////////////////
+GlDebugOutput::Kind GlDebugOutput::getKind(GLenum type)
+{
+    switch(type)
+    {
+    case GL_DEBUG_TYPE_ERROR:               return KIND_ERROR;
+    case GL_DEBUG_TYPE_PERFORMANCE:         return KIND_PERFORMANCE;
+    case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return KIND_DEPRECATED;
+    case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return KIND_UNDEFINED;
+    case GL_DEBUG_TYPE_PORTABILITY:         return KIND_PORTABILITY;
+    default:                                return KIND_OTHER;
+    }
+}
+
+const char* GlDebugOutput::getKindName(Kind kind)
+{
+    static const char* const NAMES[KIND_COUNT] = { "error", "performance", "deprecated", "undefined", "portability", "other" };
+    return NAMES[kind];
+}
+
+const char* GlDebugOutput::getSourceName(GLenum source)
+{
+    switch(source)
+    {
+    case GL_DEBUG_SOURCE_API:               return "API";
+    case GL_DEBUG_SOURCE_WINDOW_SYSTEM:     return "window system";
+    case GL_DEBUG_SOURCE_SHADER_COMPILER:   return "shader compiler";
+    case GL_DEBUG_SOURCE_THIRD_PARTY:       return "third party";
+    case GL_DEBUG_SOURCE_APPLICATION:       return "application";
+    default:                                return "other";
+    }
+}
+
+const char* GlDebugOutput::getSeverityName(GLenum severity)
+{
+    switch(severity)
+    {
+    case GL_DEBUG_SEVERITY_HIGH:            return "high";
+    case GL_DEBUG_SEVERITY_MEDIUM:          return "medium";
+    case GL_DEBUG_SEVERITY_LOW:             return "low";
+    case GL_DEBUG_SEVERITY_NOTIFICATION:    return "notification";
+    default:                                return "unknown";
+    }
+}
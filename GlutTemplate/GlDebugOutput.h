@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlDebugOutput.h
+// ===============
+// collects the messages of GL_KHR_debug / GL_ARB_debug_output, mostly for
+// performance warnings of the driver (buffer stalls, shader recompiles,
+// software fallbacks)
+//
+// Drivers report most messages only in a debug context, so create the
+// context with the debug flag first (GLUT_DEBUG, or HeadlessContext::create()
+// with debug). init() registers the callback with synchronous output, so
+// messages arrive on the render thread right in the GL call causing them.
+// The GL_KHR_debug entry points are used if supported, the ARB ones if not.
+// Messages are deduplicated by source, type, id and text; each unique
+// message is printed once when it first appears, and counted every time.
+// endFrame() makes the counts of the current frame available to the getters,
+// and printReport() lists all unique messages with their counts.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GL_DEBUG_OUTPUT_H
+#define GL_DEBUG_OUTPUT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include "glExtension.h"
+
+class GlDebugOutput
+{
+public:
+    // message types counted separately; the rest (markers, groups) are KIND_OTHER
+    enum Kind { KIND_ERROR, KIND_PERFORMANCE, KIND_DEPRECATED, KIND_UNDEFINED, KIND_PORTABILITY, KIND_OTHER, KIND_COUNT };
+
+    struct Message
+    {
+        GLenum source;
+        GLenum type;
+        GLenum severity;
+        GLuint id;
+        std::string text;
+        int count;                                  // times reported
+        unsigned long firstFrame;
+        unsigned long lastFrame;
+    };
+
+    GlDebugOutput();
+    ~GlDebugOutput();
+
+    bool init();                                    // needs GL_KHR_debug or GL_ARB_debug_output, call after RC is open
+    void release();
+    void endFrame();
+
+    bool isInitialized() const                      { return initialized; }
+    bool isDebugContext() const                     { return debugContext; }
+
+    // counts of the last finished frame
+    int getFrameCount() const;
+    int getFrameCount(Kind kind) const              { return last[kind]; }
+    int getTotalCount() const                       { return totalCount; }
+    int getUniqueCount() const                      { return (int)messages.size(); }
+    const Message* getLastPerformance() const;      // most recent performance message, 0 if none
+
+    void printReport(std::ostream& os) const;       // unique messages, most frequent first
+
+    static Kind getKind(GLenum type);
+    static const char* getKindName(Kind kind);
+    static const char* getSourceName(GLenum source);
+    static const char* getSeverityName(GLenum severity);
+
+private:
+    static void APIENTRY callback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                  GLsizei length, const GLchar* message, const void* userParam);
+    void add(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& text);
+
+    std::vector<Message> messages;                  // unique messages in order of appearance
+    std::map<std::string, int> index;               // key of message -> index in messages
+    int current[KIND_COUNT];                        // frame in progress
+    int last[KIND_COUNT];                           // last finished frame
+    int totalCount;
+    int droppedCount;                               // not stored after MAX_MESSAGES unique ones
+    int lastPerformance;                            // index in messages, -1 if none
+    unsigned long frameNumber;
+    bool initialized;
+    bool debugContext;
+    bool khr;                                       // GL_KHR_debug entry points, else ARB
+};
+
+#endif
@@ -0,0 +1,886 @@
+///////////////////////////////////////////////////////////////////////////////
+// GlReplay.cpp
+// ============
+// replays a GL command stream written by GlCapture as fast as possible
+//
+// The calls before the first frame marker (setup: shaders, buffers, textures)
+// run once, then the captured frames run back to back for the given number
+// of loops without any application work in between, so the times are the
+// cost of the GL calls alone. Each frame ends with a buffer swap, or with
+// glFinish() in a headless context, the same as vboCube does.
+// Names of GL objects and uniform locations are mapped from the captured
+// ones to the ones made by this process. Queries of state (glGet*, info logs,
+// query results, glReadPixels) are skipped; the captured program has already
+// used their results. Framebuffer 0 and any framebuffer made before the
+// capture started map to the default framebuffer of the replay, which is the
+// FBO of HeadlessContext with --headless.
+//
+// usage: glreplay FILE [--headless] [--loops N]
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+// in order to get function prototypes from glext.h, define GL_GLEXT_PROTOTYPES before including glext.h
+#define GL_GLEXT_PROTOTYPES
+#define GL_CALL_COUNTER_NO_REDIRECT             // replay with the real entry points
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include "glExtension.h"
+#include "GlCapture.h"
+#include "HeadlessContext.h"
+
+namespace
+{
+    // reads the arguments of one call record
+    class Reader
+    {
+    public:
+        Reader(const char* data, unsigned int size) : pos(data), end(data + size) {}
+
+        template<typename T> T read()
+        {
+            T value = T();
+            if(pos + sizeof(T) <= end)
+                memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        const void* readMemory(unsigned int* size = 0)     // 0 if the captured pointer was null
+        {
+            unsigned int bytes = read<unsigned int>();
+            const char* data = pos;
+            pos += bytes;
+            if(size)
+                *size = bytes;
+            return (bytes > 0 && pos <= end) ? data : 0;
+        }
+
+    private:
+        const char* pos;
+        const char* end;
+    };
+
+    // arguments are stored with fixed sizes, see GlCapture.h
+    template<typename T> struct Arg                 { static T read(Reader& r) { return r.read<T>(); } };
+    template<> struct Arg<long>                     { static long read(Reader& r) { return (long)r.read<long long>(); } };
+    template<> struct Arg<unsigned long>            { static unsigned long read(Reader& r) { return (unsigned long)r.read<unsigned long long>(); } };
+    template<typename T> struct Arg<T*>             { static T* read(Reader& r) { return (T*)(size_t)r.read<unsigned long long>(); } };
+
+    typedef void (*Handler)(Reader& r);
+
+    // replays a call by reading each argument by its parameter type
+    template<typename F, F function> struct Replay;
+
+    template<typename R, typename... Args, R (*function)(Args...)>
+    struct Replay<R (*)(Args...), function>
+    {
+        static void call(Reader& r)
+        {
+            // braced initialization reads the arguments in order
+            callWith(std::tuple<Args...>{ Arg<Args>::read(r)... }, std::index_sequence_for<Args...>());
+        }
+
+        template<size_t... I>
+        static void callWith(const std::tuple<Args...>& args, std::index_sequence<I...>)
+        {
+            function(std::get<I>(args)...);
+        }
+    };
+
+    struct Record
+    {
+        unsigned short code;
+        unsigned int size;
+        size_t offset;                              // of the data in file
+    };
+
+    struct HandlerName
+    {
+        const char* name;
+        Handler handler;                            // 0 to skip the call
+    };
+
+    // replay state
+    std::vector<char> file;
+    std::vector<Handler> handlers(65536, (Handler)0);
+    std::map<GLuint, GLuint> buffers, textures, framebuffers, renderbuffers, queries, shaders, programs;
+    std::map<std::pair<GLuint, GLint>, GLint> uniformLocations;     // (program, captured) -> own
+    std::map<GLint, GLint> attribLocations;
+    std::map<GLenum, char*> mappedBuffers;          // pointer of glMapBufferRange() per target
+    GLuint currentProgram = 0;                      // captured name
+    GLuint defaultFramebuffer = 0;
+    int width = 0;
+    int height = 0;
+    bool headless = false;
+    int loops = 10;
+    int frameCount = 0;
+    long long callCount = 0;                        // per loop
+    size_t setupEnd = 0;                            // index of first frame record
+    std::vector<Record> records;
+    HeadlessContext headlessContext;
+
+    GLuint mapName(const std::map<GLuint, GLuint>& names, GLuint name)
+    {
+        std::map<GLuint, GLuint>::const_iterator it = names.find(name);
+        return it != names.end() ? it->second : name;
+    }
+
+    GLint mapUniform(GLint location)
+    {
+        std::map<std::pair<GLuint, GLint>, GLint>::const_iterator it = uniformLocations.find(std::make_pair(currentProgram, location));
+        return it != uniformLocations.end() ? it->second : location;
+    }
+
+    GLint mapAttrib(GLint location)
+    {
+        std::map<GLint, GLint>::const_iterator it = attribLocations.find(location);
+        return it != attribLocations.end() ? it->second : location;
+    }
+
+    // vertex array pointers are offsets into the bound buffer; client arrays were not captured
+    bool hasArrayBuffer()
+    {
+        GLint buffer = 0;
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &buffer);
+        if(buffer == 0)
+        {
+            static bool warned = false;
+            if(!warned)
+                std::cout << "[WARNING] Skipped vertex array pointers without buffer object." << std::endl;
+            warned = true;
+        }
+        return buffer != 0;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// object names, captured names are mapped to the names made here
+///////////////////////////////////////////////////////////////////////////////
+template<void (*gen)(GLsizei, GLuint*), std::map<GLuint, GLuint>* names>
+static void replayGen(Reader& r)
+{
+    GLsizei n = r.read<GLsizei>();
+    const GLuint* captured = (const GLuint*)r.readMemory();
+    std::vector<GLuint> own(n);
+    gen(n, own.data());
+    for(GLsizei i = 0; captured && i < n; ++i)
+        (*names)[captured[i]] = own[i];
+}
+
+template<void (*del)(GLsizei, const GLuint*), std::map<GLuint, GLuint>* names>
+static void replayDelete(Reader& r)
+{
+    GLsizei n = r.read<GLsizei>();
+    const GLuint* captured = (const GLuint*)r.readMemory();
+    std::vector<GLuint> own;
+    for(GLsizei i = 0; captured && i < n; ++i)
+    {
+        std::map<GLuint, GLuint>::iterator it = names->find(captured[i]);
+        if(it == names->end())
+            continue;
+        own.push_back(it->second);
+        names->erase(it);
+    }
+    if(!own.empty())
+        del((GLsizei)own.size(), own.data());
+}
+
+static void replayBindBuffer(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    glBindBuffer(target, mapName(buffers, r.read<GLuint>()));
+}
+
+static void replayBindBufferBase(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLuint index = r.read<GLuint>();
+    glBindBufferBase(target, index, mapName(buffers, r.read<GLuint>()));
+}
+
+static void replayBindTexture(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    glBindTexture(target, mapName(textures, r.read<GLuint>()));
+}
+
+static void replayBindFramebuffer(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLuint name = r.read<GLuint>();
+    std::map<GLuint, GLuint>::const_iterator it = framebuffers.find(name);
+    glBindFramebuffer(target, it != framebuffers.end() ? it->second : defaultFramebuffer);
+}
+
+static void replayBindRenderbuffer(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    glBindRenderbuffer(target, mapName(renderbuffers, r.read<GLuint>()));
+}
+
+static void replayFramebufferRenderbuffer(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLenum attachment = r.read<GLenum>();
+    GLenum renderbufferTarget = r.read<GLenum>();
+    glFramebufferRenderbuffer(target, attachment, renderbufferTarget, mapName(renderbuffers, r.read<GLuint>()));
+}
+
+static void replayBeginQuery(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    glBeginQuery(target, mapName(queries, r.read<GLuint>()));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// shaders and programs
+///////////////////////////////////////////////////////////////////////////////
+static void replayCreateShader(Reader& r)
+{
+    GLenum type = r.read<GLenum>();
+    GLuint captured = r.read<GLuint>();
+    shaders[captured] = glCreateShader(type);
+}
+
+static void replayCreateProgram(Reader& r)
+{
+    GLuint captured = r.read<GLuint>();
+    programs[captured] = glCreateProgram();
+}
+
+// a list of NUL terminated strings, see GlCapture.cpp
+static void readStrings(Reader& r, std::vector<const GLchar*>& strings)
+{
+    GLsizei count = r.read<GLsizei>();
+    for(GLsizei i = 0; i < count; ++i)
+    {
+        const GLchar* str = (const GLchar*)r.readMemory();
+        strings.push_back(str ? str : "");
+    }
+}
+
+static void replayShaderSource(Reader& r)
+{
+    GLuint shader = mapName(shaders, r.read<GLuint>());
+    std::vector<const GLchar*> strings;
+    readStrings(r, strings);
+    glShaderSource(shader, (GLsizei)strings.size(), strings.data(), 0);
+}
+
+static void replayCompileShader(Reader& r)
+{
+    glCompileShader(mapName(shaders, r.read<GLuint>()));
+}
+
+static void replayDeleteShader(Reader& r)
+{
+    GLuint captured = r.read<GLuint>();
+    glDeleteShader(mapName(shaders, captured));
+    shaders.erase(captured);
+}
+
+static void replayAttachShader(Reader& r)
+{
+    GLuint program = mapName(programs, r.read<GLuint>());
+    glAttachShader(program, mapName(shaders, r.read<GLuint>()));
+}
+
+static void replayTransformFeedbackVaryings(Reader& r)
+{
+    GLuint program = mapName(programs, r.read<GLuint>());
+    std::vector<const GLchar*> varyings;
+    readStrings(r, varyings);
+    glTransformFeedbackVaryings(program, (GLsizei)varyings.size(), varyings.data(), r.read<GLenum>());
+}
+
+static void replayLinkProgram(Reader& r)
+{
+    glLinkProgram(mapName(programs, r.read<GLuint>()));
+}
+
+static void replayUseProgram(Reader& r)
+{
+    currentProgram = r.read<GLuint>();
+    glUseProgram(mapName(programs, currentProgram));
+}
+
+static void replayDeleteProgram(Reader& r)
+{
+    GLuint captured = r.read<GLuint>();
+    glDeleteProgram(mapName(programs, captured));
+    programs.erase(captured);
+}
+
+static void replayGetUniformLocation(Reader& r)
+{
+    GLuint program = r.read<GLuint>();
+    const GLchar* name = (const GLchar*)r.readMemory();
+    GLint captured = r.read<GLint>();
+    if(name)
+        uniformLocations[std::make_pair(program, captured)] = glGetUniformLocation(mapName(programs, program), name);
+}
+
+static void replayGetAttribLocation(Reader& r)
+{
+    GLuint program = r.read<GLuint>();
+    const GLchar* name = (const GLchar*)r.readMemory();
+    GLint captured = r.read<GLint>();
+    if(name && captured >= 0)
+        attribLocations[captured] = glGetAttribLocation(mapName(programs, program), name);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// uniforms and vertex attributes with mapped locations
+///////////////////////////////////////////////////////////////////////////////
+static void replayUniform1i(Reader& r)
+{
+    GLint location = mapUniform(r.read<GLint>());
+    glUniform1i(location, r.read<GLint>());
+}
+
+static void replayUniform1f(Reader& r)
+{
+    GLint location = mapUniform(r.read<GLint>());
+    glUniform1f(location, r.read<GLfloat>());
+}
+
+static void replayUniform2f(Reader& r)
+{
+    GLint location = mapUniform(r.read<GLint>());
+    GLfloat x = r.read<GLfloat>();
+    glUniform2f(location, x, r.read<GLfloat>());
+}
+
+static void replayUniform3fv(Reader& r)
+{
+    GLint location = mapUniform(r.read<GLint>());
+    GLsizei count = r.read<GLsizei>();
+    const GLfloat* value = (const GLfloat*)r.readMemory();
+    if(value)
+        glUniform3fv(location, count, value);
+}
+
+static void replayUniformMatrix4fv(Reader& r)
+{
+    GLint location = mapUniform(r.read<GLint>());
+    GLsizei count = r.read<GLsizei>();
+    GLboolean transpose = r.read<GLboolean>();
+    const GLfloat* value = (const GLfloat*)r.readMemory();
+    if(value)
+        glUniformMatrix4fv(location, count, transpose, value);
+}
+
+static void replayEnableVertexAttribArray(Reader& r)
+{
+    glEnableVertexAttribArray(mapAttrib(r.read<GLuint>()));
+}
+
+static void replayDisableVertexAttribArray(Reader& r)
+{
+    glDisableVertexAttribArray(mapAttrib(r.read<GLuint>()));
+}
+
+static void replayVertexAttribDivisor(Reader& r)
+{
+    GLuint index = mapAttrib(r.read<GLuint>());
+    glVertexAttribDivisor(index, r.read<GLuint>());
+}
+
+static void replayVertexAttribPointer(Reader& r)
+{
+    GLuint index = mapAttrib(r.read<GLuint>());
+    GLint size = r.read<GLint>();
+    GLenum type = r.read<GLenum>();
+    GLboolean normalized = r.read<GLboolean>();
+    GLsizei stride = r.read<GLsizei>();
+    const void* pointer = Arg<const void*>::read(r);
+    if(hasArrayBuffer())
+        glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+// fixed-function arrays: glVertexPointer(), glColorPointer(), ...
+template<typename F, F function>
+static void replayArrayPointer(Reader& r)
+{
+    if(hasArrayBuffer())
+        Replay<F, function>::call(r);
+}
+
+static void replayNormalPointer(Reader& r)
+{
+    if(hasArrayBuffer())
+        Replay<decltype(&glNormalPointer), &glNormalPointer>::call(r);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// calls passing memory
+///////////////////////////////////////////////////////////////////////////////
+static void replayBufferData(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLsizeiptr size = (GLsizeiptr)r.read<long long>();
+    const void* data = r.readMemory();
+    glBufferData(target, size, data, r.read<GLenum>());
+}
+
+static void replayBufferSubData(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLintptr offset = (GLintptr)r.read<long long>();
+    unsigned int size = 0;
+    const void* data = r.readMemory(&size);
+    if(data)
+        glBufferSubData(target, offset, size, data);
+}
+
+static void replayMapBufferRange(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLintptr offset = (GLintptr)r.read<long long>();
+    GLsizeiptr length = (GLsizeiptr)r.read<long long>();
+    mappedBuffers[target] = (char*)glMapBufferRange(target, offset, length, r.read<GLbitfield>());
+}
+
+static void replayFlushMappedBufferRange(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLintptr offset = (GLintptr)r.read<long long>();
+    unsigned int size = 0;
+    const void* data = r.readMemory(&size);
+    char* pointer = mappedBuffers[target];
+    if(pointer && data)
+        memcpy(pointer + offset, data, size);
+    glFlushMappedBufferRange(target, offset, size);
+}
+
+static void replayUnmapBuffer(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    unsigned int size = 0;
+    const void* data = r.readMemory(&size);
+    char* pointer = mappedBuffers[target];
+    if(pointer && data)
+        memcpy(pointer, data, size);
+    mappedBuffers[target] = 0;
+    glUnmapBuffer(target);
+}
+
+static void replayLightfv(Reader& r)
+{
+    GLenum light = r.read<GLenum>();
+    GLenum pname = r.read<GLenum>();
+    const GLfloat* params = (const GLfloat*)r.readMemory();
+    if(params)
+        glLightfv(light, pname, params);
+}
+
+static void replayLoadMatrixf(Reader& r)
+{
+    const GLfloat* m = (const GLfloat*)r.readMemory();
+    if(m)
+        glLoadMatrixf(m);
+}
+
+static void replayMultMatrixf(Reader& r)
+{
+    const GLfloat* m = (const GLfloat*)r.readMemory();
+    if(m)
+        glMultMatrixf(m);
+}
+
+static void replayTexImage2D(Reader& r)
+{
+    GLenum target = r.read<GLenum>();
+    GLint level = r.read<GLint>();
+    GLint internalFormat = r.read<GLint>();
+    GLsizei w = r.read<GLsizei>();
+    GLsizei h = r.read<GLsizei>();
+    GLint border = r.read<GLint>();
+    GLenum format = r.read<GLenum>();
+    GLenum type = r.read<GLenum>();
+    const void* pixels = r.readMemory();
+    glTexImage2D(target, level, internalFormat, w, h, border, format, type, pixels);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// handlers by entry point name; a DEFINE record assigns one to a captured id
+///////////////////////////////////////////////////////////////////////////////
+#define REPLAY(name)        { #name, &Replay<decltype(&name), &name>::call }
+#define REPLAY_ARRAY(name)  { #name, &replayArrayPointer<decltype(&name), &name> }
+#define SKIP(name)          { #name, 0 }
+
+static const HandlerName HANDLERS[] =
+{
+    // draw calls
+    REPLAY(glDrawArrays),
+    REPLAY(glDrawArraysInstanced),
+    REPLAY(glDrawElements),
+    REPLAY(glDrawElementsInstanced),
+    REPLAY(glClear),
+    REPLAY(glBeginTransformFeedback),
+    REPLAY(glEndTransformFeedback),
+
+    // buffers
+    { "glGenBuffers",               &replayGen<&glGenBuffers, &buffers> },
+    { "glDeleteBuffers",            &replayDelete<&glDeleteBuffers, &buffers> },
+    { "glBindBuffer",               &replayBindBuffer },
+    { "glBindBufferBase",           &replayBindBufferBase },
+    { "glBufferData",               &replayBufferData },
+    { "glBufferSubData",            &replayBufferSubData },
+    { "glMapBufferRange",           &replayMapBufferRange },
+    { "glFlushMappedBufferRange",   &replayFlushMappedBufferRange },
+    { "glUnmapBuffer",              &replayUnmapBuffer },
+    REPLAY(glCopyBufferSubData),
+    SKIP(glGetBufferParameteriv),
+
+    // vertex arrays
+    REPLAY_ARRAY(glVertexPointer),
+    REPLAY_ARRAY(glColorPointer),
+    REPLAY_ARRAY(glTexCoordPointer),
+    { "glNormalPointer",            &replayNormalPointer },
+    { "glVertexAttribPointer",      &replayVertexAttribPointer },
+    { "glVertexAttribDivisor",      &replayVertexAttribDivisor },
+    { "glEnableVertexAttribArray",  &replayEnableVertexAttribArray },
+    { "glDisableVertexAttribArray", &replayDisableVertexAttribArray },
+    REPLAY(glEnableClientState),
+    REPLAY(glDisableClientState),
+    REPLAY(glBindVertexArray),
+    SKIP(glDeleteVertexArrays),                     // vertex array objects are not made by vboCube
+
+    // shaders and uniforms
+    { "glCreateShader",             &replayCreateShader },
+    { "glShaderSource",             &replayShaderSource },
+    { "glCompileShader",            &replayCompileShader },
+    { "glDeleteShader",             &replayDeleteShader },
+    { "glCreateProgram",            &replayCreateProgram },
+    { "glAttachShader",             &replayAttachShader },
+    { "glTransformFeedbackVaryings", &replayTransformFeedbackVaryings },
+    { "glLinkProgram",              &replayLinkProgram },
+    { "glUseProgram",               &replayUseProgram },
+    { "glDeleteProgram",            &replayDeleteProgram },
+    { "glGetUniformLocation",       &replayGetUniformLocation },
+    { "glGetAttribLocation",        &replayGetAttribLocation },
+    { "glUniform1i",                &replayUniform1i },
+    { "glUniform1f",                &replayUniform1f },
+    { "glUniform2f",                &replayUniform2f },
+    { "glUniform3fv",               &replayUniform3fv },
+    { "glUniformMatrix4fv",         &replayUniformMatrix4fv },
+    SKIP(glGetShaderiv),
+    SKIP(glGetShaderInfoLog),
+    SKIP(glGetProgramiv),
+    SKIP(glGetProgramInfoLog),
+
+    // textures, framebuffers and queries
+    { "glGenTextures",              &replayGen<&glGenTextures, &textures> },
+    { "glDeleteTextures",           &replayDelete<&glDeleteTextures, &textures> },
+    { "glBindTexture",              &replayBindTexture },
+    { "glTexImage2D",               &replayTexImage2D },
+    REPLAY(glTexParameteri),
+    REPLAY(glTexEnvi),
+    REPLAY(glPixelStorei),
+    REPLAY(glActiveTexture),
+    { "glGenFramebuffers",          &replayGen<&glGenFramebuffers, &framebuffers> },
+    { "glDeleteFramebuffers",       &replayDelete<&glDeleteFramebuffers, &framebuffers> },
+    { "glBindFramebuffer",          &replayBindFramebuffer },
+    { "glGenRenderbuffers",         &replayGen<&glGenRenderbuffers, &renderbuffers> },
+    { "glDeleteRenderbuffers",      &replayDelete<&glDeleteRenderbuffers, &renderbuffers> },
+    { "glBindRenderbuffer",         &replayBindRenderbuffer },
+    { "glFramebufferRenderbuffer",  &replayFramebufferRenderbuffer },
+    REPLAY(glRenderbufferStorage),
+    REPLAY(glDrawBuffer),
+    REPLAY(glReadBuffer),
+    SKIP(glCheckFramebufferStatus),
+    SKIP(glReadPixels),
+    { "glGenQueries",               &replayGen<&glGenQueries, &queries> },
+    { "glDeleteQueries",            &replayDelete<&glDeleteQueries, &queries> },
+    { "glBeginQuery",               &replayBeginQuery },
+    REPLAY(glEndQuery),
+    SKIP(glGetQueryObjectiv),
+    SKIP(glGetQueryObjectui64v),
+
+    // fixed-function state and matrices
+    REPLAY(glEnable),
+    REPLAY(glDisable),
+    REPLAY(glBlendFunc),
+    REPLAY(glDepthMask),
+    REPLAY(glPolygonMode),
+    REPLAY(glPushAttrib),
+    REPLAY(glPopAttrib),
+    REPLAY(glPushClientAttrib),
+    REPLAY(glPopClientAttrib),
+    REPLAY(glMatrixMode),
+    REPLAY(glLoadIdentity),
+    { "glLoadMatrixf",              &replayLoadMatrixf },
+    { "glMultMatrixf",              &replayMultMatrixf },
+    REPLAY(glPushMatrix),
+    REPLAY(glPopMatrix),
+    REPLAY(glRotatef),
+    REPLAY(glOrtho),
+    REPLAY(glViewport),
+    { "glLightfv",                  &replayLightfv },
+    REPLAY(glColorMaterial),
+    REPLAY(glShadeModel),
+    REPLAY(glHint),
+    REPLAY(glDepthFunc),
+    REPLAY(glClearColor),
+    REPLAY(glClearDepth),
+    REPLAY(glClearStencil),
+
+    // queries and synchronization
+    SKIP(glGetString),
+    SKIP(glGetIntegerv),
+    SKIP(glGetError),
+    REPLAY(glFlush),
+    REPLAY(glFinish),
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return time in seconds
+///////////////////////////////////////////////////////////////////////////////
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read the file and split it into records
+// DEFINE records are resolved here and do not become records.
+///////////////////////////////////////////////////////////////////////////////
+static bool load(const std::string& fileName)
+{
+    std::ifstream in(fileName.c_str(), std::ios::binary);
+    if(!in)
+    {
+        std::cout << "[load()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+    file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    const size_t HEADER_SIZE = sizeof(GlCapture::MAGIC) + 3 * sizeof(unsigned int);
+    unsigned int header[3] = { 0, 0, 0 };
+    if(file.size() < HEADER_SIZE || memcmp(&file[0], GlCapture::MAGIC, sizeof(GlCapture::MAGIC)) != 0)
+    {
+        std::cout << "[load()] " << fileName << " is not a GL capture file." << std::endl;
+        return false;
+    }
+    memcpy(header, &file[sizeof(GlCapture::MAGIC)], sizeof(header));
+    if(header[0] != GlCapture::VERSION)
+    {
+        std::cout << "[load()] Unsupported capture version " << header[0] << "." << std::endl;
+        return false;
+    }
+    width = (int)header[1];
+    height = (int)header[2];
+
+    const size_t RECORD_HEADER = sizeof(unsigned short) + sizeof(unsigned int);
+    size_t pos = HEADER_SIZE;
+    bool setupDone = false;
+    while(pos + RECORD_HEADER <= file.size())
+    {
+        Record record;
+        memcpy(&record.code, &file[pos], sizeof(record.code));
+        memcpy(&record.size, &file[pos + sizeof(record.code)], sizeof(record.size));
+        record.offset = pos + RECORD_HEADER;
+        pos = record.offset + record.size;
+        if(pos > file.size())
+            break;                                  // truncated, e.g. the program was killed
+
+        if(record.code == GlCapture::DEFINE_RECORD)
+        {
+            unsigned short id = 0;
+            memcpy(&id, &file[record.offset], sizeof(id));
+            std::string name(&file[record.offset + sizeof(id)], record.size - sizeof(id));
+            bool found = false;
+            for(size_t i = 0; i < sizeof(HANDLERS) / sizeof(HANDLERS[0]); ++i)
+            {
+                if(name == HANDLERS[i].name)
+                {
+                    handlers[id] = HANDLERS[i].handler;
+                    found = true;
+                    break;
+                }
+            }
+            if(!found)
+                std::cout << "[WARNING] " << name << " is not supported, its calls are skipped." << std::endl;
+            continue;
+        }
+
+        if(record.code == GlCapture::FRAME_RECORD)
+        {
+            if(!setupDone)
+                setupEnd = records.size() + 1;
+            else
+                ++frameCount;
+            setupDone = true;
+        }
+        else if(setupDone)
+        {
+            ++callCount;
+        }
+        records.push_back(record);
+    }
+
+    if(frameCount == 0)
+    {
+        std::cout << "[load()] " << fileName << " has no complete frame." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run records [first, last); a frame record finishes the frame
+///////////////////////////////////////////////////////////////////////////////
+static void run(size_t first, size_t last, std::vector<double>& frameTimes)
+{
+    double frameStart = now();
+    for(size_t i = first; i < last; ++i)
+    {
+        const Record& record = records[i];
+        if(record.code == GlCapture::FRAME_RECORD)
+        {
+            if(headless)
+                glFinish();
+            else
+                glutSwapBuffers();
+            double t = now();
+            frameTimes.push_back((t - frameStart) * 1000);
+            frameStart = t;
+            continue;
+        }
+
+        Handler handler = handlers[record.code];
+        if(handler)
+        {
+            Reader r(&file[record.offset], record.size);
+            handler(r);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// replay setup once and the frames for all loops, then print frame times
+///////////////////////////////////////////////////////////////////////////////
+static void replay()
+{
+    std::vector<double> setupTime;
+    run(0, setupEnd, setupTime);
+
+    std::vector<double> frameTimes;
+    double start = now();
+    for(int i = 0; i < loops; ++i)
+        run(setupEnd, records.size(), frameTimes);
+    double seconds = now() - start;
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double sum = 0;
+    for(size_t i = 0; i < frameTimes.size(); ++i)
+        sum += frameTimes[i];
+
+    char line[256];
+    snprintf(line, sizeof(line), "Setup %.2f ms, %d frames x %d loops: avg %.3f ms, min %.3f ms, median %.3f ms, max %.3f ms",
+             setupTime.empty() ? 0.0 : setupTime[0], frameCount, loops, sum / frameTimes.size(),
+             frameTimes.front(), frameTimes[frameTimes.size() / 2], frameTimes.back());
+    std::cout << line << std::endl;
+    snprintf(line, sizeof(line), "%lld calls per frame, %.0f calls/s",
+             callCount / frameCount, callCount * loops / seconds);
+    std::cout << line << std::endl;
+
+    // the captured program may have raised errors too, so this is only a hint
+    GLenum error = glGetError();
+    if(error != GL_NO_ERROR)
+        std::cout << "[WARNING] GL error 0x" << std::hex << error << std::dec << " during replay." << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// GLUT callback: replay once the window is shown, then exit
+///////////////////////////////////////////////////////////////////////////////
+static void displayCB()
+{
+    replay();
+    exit(0);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    std::string fileName;
+    bool usage = false;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if(strcmp(argv[i], "--loops") == 0 && i + 1 < argc)
+            loops = std::max(1, atoi(argv[++i]));
+        else if(argv[i][0] != '-' && fileName.empty())
+            fileName = argv[i];
+        else
+            usage = true;
+    }
+    if(usage || fileName.empty())
+    {
+        std::cout << "usage: " << argv[0] << " FILE [--headless] [--loops N]" << std::endl;
+        return 2;
+    }
+
+    if(!load(fileName))
+        return 1;
+    std::cout << "Replaying " << frameCount << " frames of " << fileName << " (" << width << "x" << height << ")" << std::endl;
+
+    if(headless)
+    {
+        if(!headlessContext.create(width, height))
+            return 1;
+        defaultFramebuffer = headlessContext.getFramebufferId();
+        replay();
+        return 0;
+    }
+
+    glutInit(&argc, argv);
+    glutInitDisplayMode(GLUT_RGBA | GLUT_DOUBLE | GLUT_DEPTH | GLUT_STENCIL);
+    glutInitWindowSize(width, height);
+    glutCreateWindow(argv[0]);
+    glutDisplayFunc(displayCB);
+    glutMainLoop();
+    return 0;
+}
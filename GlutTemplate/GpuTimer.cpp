@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// GpuTimer.cpp
+// ============
+// GPU time of frame sections measured with GL_TIME_ELAPSED queries
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuTimer.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+GpuTimer::GpuTimer() : timerCount(0), current(-1), newest(0), oldest(0), active(-1), droppedFrames(0)
+{
+}
+GpuTimer::~GpuTimer()
+{
+    // the queries must be released by release() while RC is still open
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create depth x timerCount query objects
+///////////////////////////////////////////////////////////////////////////////
+bool GpuTimer::init(int timerCount, int depth)
+{
+    release();
+    if(timerCount < 1 || depth < 2)
+        return false;
+
+    this->timerCount = timerCount;
+    queryIds.resize(depth * timerCount);
+    glGenQueries((GLsizei)queryIds.size(), &queryIds[0]);
+
+    slots.resize(depth);
+    for(int i = 0; i < depth; ++i)
+    {
+        slots[i].frameNumber = 0;
+        slots[i].pending = false;
+        slots[i].used.assign(timerCount, 0);
+    }
+    current = -1;
+    newest = oldest = 0;
+    active = -1;
+    droppedFrames = 0;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete query objects
+///////////////////////////////////////////////////////////////////////////////
+void GpuTimer::release()
+{
+    if(!queryIds.empty())
+        glDeleteQueries((GLsizei)queryIds.size(), &queryIds[0]);
+    queryIds.clear();
+    slots.clear();
+    timerCount = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take the next slot of the ring; skip timing if it is still pending
+///////////////////////////////////////////////////////////////////////////////
+void GpuTimer::beginFrame(unsigned long frameNumber)
+{
+    current = -1;
+    if(slots.empty())
+        return;
+
+    Slot& slot = slots[newest];
+    if(slot.pending)
+    {
+        ++droppedFrames;
+        return;
+    }
+
+    slot.frameNumber = frameNumber;
+    slot.used.assign(timerCount, 0);
+    current = newest;
+    newest = (newest + 1) % (int)slots.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start/stop the query of a timer in current frame
+///////////////////////////////////////////////////////////////////////////////
+void GpuTimer::begin(int timer)
+{
+    if(current < 0 || timer < 0 || timer >= timerCount || active >= 0)
+        return;
+
+    glBeginQuery(GL_TIME_ELAPSED, queryIds[current * timerCount + timer]);
+    slots[current].used[timer] = 1;
+    active = timer;
+}
+
+void GpuTimer::end(int timer)
+{
+    if(current < 0 || timer != active)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    active = -1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// mark the queries of the frame to be read later
+///////////////////////////////////////////////////////////////////////////////
+void GpuTimer::endFrame()
+{
+    if(current < 0)
+        return;
+
+    if(active >= 0)
+        end(active);
+    slots[current].pending = true;
+    current = -1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read the oldest pending frame if all its results are available
+// GL_QUERY_RESULT_AVAILABLE does not block; GL_QUERY_RESULT is read only
+// after it reports true.
+///////////////////////////////////////////////////////////////////////////////
+bool GpuTimer::poll(unsigned long& frameNumber, long long* times)
+{
+    if(slots.empty())
+        return false;
+
+    // slots are filled in ring order, so the oldest is always next to read
+    int index = oldest;
+    if(!slots[index].pending)
+        return false;
+
+    Slot& slot = slots[index];
+    for(int i = 0; i < timerCount; ++i)
+    {
+        if(!slot.used[i])
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(queryIds[index * timerCount + i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if(!available)
+            return false;
+    }
+
+    for(int i = 0; i < timerCount; ++i)
+    {
+        times[i] = -1;
+        if(!slot.used[i])
+            continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queryIds[index * timerCount + i], GL_QUERY_RESULT, &ns);
+        times[i] = (long long)ns;
+    }
+
+    frameNumber = slot.frameNumber;
+    slot.pending = false;
+    oldest = (index + 1) % (int)slots.size();
+    return true;
+}
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+// GpuTimer.h
+// ==========
+// GPU time of frame sections measured with GL_TIME_ELAPSED queries
+//
+// A frame may contain several timers (sections), begun and ended in order;
+// they must not overlap since only one GL_TIME_ELAPSED query can be active.
+// The queries of a frame go into one slot of a ring that is several frames
+// deep. poll() returns the results of the oldest slot only once all of its
+// queries are available, so reading them never waits for the GPU. If the
+// GPU falls so far behind that the slot to reuse is still pending, that
+// frame is not timed instead of stalling.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <vector>
+#include "glExtension.h"
+
+class GpuTimer
+{
+public:
+    GpuTimer();
+    ~GpuTimer();
+
+    bool init(int timerCount, int depth=4);         // needs GL_ARB_timer_query, call after RC is open
+    void release();
+
+    void beginFrame(unsigned long frameNumber);
+    void begin(int timer);
+    void end(int timer);
+    void endFrame();
+
+    // results of the oldest finished frame in ns; times[timer] is -1 if the
+    // timer was not used in that frame. Return false if nothing is ready.
+    bool poll(unsigned long& frameNumber, long long* times);
+
+    int getTimerCount() const                       { return timerCount; }
+    int getDroppedFrames() const                    { return droppedFrames; }
+    bool isInitialized() const                      { return !queryIds.empty(); }
+
+private:
+    struct Slot
+    {
+        unsigned long frameNumber;
+        bool pending;                               // queries issued, results not read yet
+        std::vector<char> used;                     // per timer, query was issued in this frame
+    };
+
+    std::vector<GLuint> queryIds;                   // depth * timerCount
+    std::vector<Slot> slots;
+    int timerCount;
+    int current;                                    // slot of frame in progress, -1 if not timed
+    int newest;                                     // next slot to fill
+    int oldest;                                     // next slot to poll
+    int active;                                     // timer running now, -1 if none
+    int droppedFrames;
+};
+
+#endif
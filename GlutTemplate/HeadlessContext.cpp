@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+// HeadlessContext.cpp
+// ===================
+// OpenGL context without a window for benchmark runs on build servers
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <cstring>
+#include <sstream>
+#include "HeadlessContext.h"
+
+#ifdef __linux__
+#define EGL_NO_X11                                  // no Xlib macros (None, Bool) in this file
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext() : display(0), context(0), surface(0), fboId(0), colorId(0), depthId(0),
+                                     width(0), height(0)
+{
+}
+HeadlessContext::~HeadlessContext()
+{
+    destroy();
+}
+
+
+
+#ifdef __linux__
+///////////////////////////////////////////////////////////////////////////////
+// open EGL display, create a compatibility context and make it current
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessContext::create(int width, int height, bool debug)
+{
+    destroy();
+    this->width = width;
+    this->height = height;
+
+    // prefer the surfaceless platform, it needs neither X11 nor a GPU device
+    const char* clientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+    bool surfacelessPlatform = false;
+    if(clientExts && strstr(clientExts, "EGL_MESA_platform_surfaceless"))
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if(getPlatformDisplay)
+            dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+        surfacelessPlatform = dpy != EGL_NO_DISPLAY;
+    }
+    if(dpy == EGL_NO_DISPLAY)
+        dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major = 0, minor = 0;
+    if(dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor))
+    {
+        std::cout << "[HeadlessContext::create()] Failed to initialize EGL display." << std::endl;
+        return false;
+    }
+    display = dpy;
+
+    if(!eglBindAPI(EGL_OPENGL_API))
+    {
+        std::cout << "[HeadlessContext::create()] EGL does not support desktop OpenGL." << std::endl;
+        destroy();
+        return false;
+    }
+
+    // a config is only needed for the pbuffer fallback
+    const char* dpyExts = eglQueryString(dpy, EGL_EXTENSIONS);
+    bool noConfig = dpyExts && strstr(dpyExts, "EGL_KHR_no_config_context");
+    bool noSurface = dpyExts && strstr(dpyExts, "EGL_KHR_surfaceless_context");
+    EGLConfig config = 0;
+    if(!noConfig || !noSurface)
+    {
+        const EGLint configAttribs[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                         EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                         EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+                                         EGL_NONE };
+        EGLint configCount = 0;
+        if(!eglChooseConfig(dpy, configAttribs, &config, 1, &configCount) || configCount < 1)
+        {
+            std::cout << "[HeadlessContext::create()] No EGL config for OpenGL." << std::endl;
+            destroy();
+            return false;
+        }
+    }
+
+    // the debug flag is core in EGL 1.5, and a context flag of EGL_KHR_create_context before
+    EGLint debugAttribs[3] = { EGL_NONE, EGL_NONE, EGL_NONE };
+    if(debug && (major > 1 || minor >= 5))
+    {
+        debugAttribs[0] = EGL_CONTEXT_OPENGL_DEBUG;
+        debugAttribs[1] = EGL_TRUE;
+    }
+    else if(debug && dpyExts && strstr(dpyExts, "EGL_KHR_create_context"))
+    {
+        debugAttribs[0] = EGL_CONTEXT_FLAGS_KHR;
+        debugAttribs[1] = EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+    }
+    EGLConfig contextConfig = noConfig && noSurface ? EGL_NO_CONFIG_KHR : config;
+    EGLContext ctx = eglCreateContext(dpy, contextConfig, EGL_NO_CONTEXT, debugAttribs);
+    if(ctx == EGL_NO_CONTEXT && debugAttribs[0] != EGL_NONE)
+    {
+        std::cout << "[HeadlessContext::create()] Failed to create EGL debug context, creating a normal one." << std::endl;
+        ctx = eglCreateContext(dpy, contextConfig, EGL_NO_CONTEXT, 0);
+    }
+    if(ctx == EGL_NO_CONTEXT)
+    {
+        std::cout << "[HeadlessContext::create()] Failed to create EGL context." << std::endl;
+        destroy();
+        return false;
+    }
+    context = ctx;
+
+    EGLSurface surf = EGL_NO_SURFACE;
+    if(!noSurface)
+    {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        surf = eglCreatePbufferSurface(dpy, config, pbufferAttribs);
+        surface = surf != EGL_NO_SURFACE ? surf : 0;
+    }
+    if(!eglMakeCurrent(dpy, surf, surf, ctx))
+    {
+        std::cout << "[HeadlessContext::create()] Failed to make EGL context current." << std::endl;
+        destroy();
+        return false;
+    }
+
+    std::stringstream ss;
+    ss << "EGL " << major << "." << minor << (surfacelessPlatform ? " surfaceless" : (noSurface ? " no surface" : " pbuffer"));
+    description = ss.str();
+
+    if(!createFramebuffer())
+    {
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// release FBO and EGL objects
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessContext::destroy()
+{
+    if(context)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if(fboId)
+            glDeleteFramebuffers(1, &fboId);
+        if(colorId)
+            glDeleteRenderbuffers(1, &colorId);
+        if(depthId)
+            glDeleteRenderbuffers(1, &depthId);
+        eglMakeCurrent((EGLDisplay)display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext((EGLDisplay)display, (EGLContext)context);
+    }
+    if(surface)
+        eglDestroySurface((EGLDisplay)display, (EGLSurface)surface);
+    if(display)
+        eglTerminate((EGLDisplay)display);
+
+    display = context = surface = 0;
+    fboId = colorId = depthId = 0;
+    description.clear();
+}
+
+#else
+///////////////////////////////////////////////////////////////////////////////
+// no headless context on this platform
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessContext::create(int, int, bool)
+{
+    std::cout << "[HeadlessContext::create()] Headless mode is only supported on Linux with EGL." << std::endl;
+    return false;
+}
+
+void HeadlessContext::destroy()
+{
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create and bind FBO with color and depth-stencil renderbuffers
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessContext::createFramebuffer()
+{
+    glGenRenderbuffers(1, &colorId);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorId);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &depthId);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthId);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fboId);
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorId);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthId);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthId);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "[HeadlessContext::createFramebuffer()] FBO is not complete: 0x" << std::hex << status
+                  << std::dec << std::endl;
+        return false;
+    }
+
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    return true;
+}
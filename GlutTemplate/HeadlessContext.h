@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+// HeadlessContext.h
+// =================
+// OpenGL context without a window for benchmark runs on build servers
+//
+// On Linux, the context is created with EGL on the surfaceless platform
+// (EGL_MESA_platform_surfaceless), which works with llvmpipe on machines
+// without a display server or GPU. If that platform is not available, the
+// default EGL display is used. The context is the compatibility profile,
+// the same as a GLUT window.
+// There is no default framebuffer, so create() also makes an FBO of the
+// given size with RGBA8 color and 24/8 depth-stencil renderbuffers, and
+// leaves it bound. Everything drawn afterwards goes into the FBO.
+// With debug, the context is created with the debug flag for GlDebugOutput,
+// or without it if the driver refuses.
+// On other platforms create() fails and the program needs a window.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef HEADLESS_CONTEXT_H
+#define HEADLESS_CONTEXT_H
+
+#include <string>
+#include "glExtension.h"
+
+class HeadlessContext
+{
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    bool create(int width, int height, bool debug=false);   // make context current with bound FBO
+    void destroy();
+
+    bool isCreated() const                          { return context != 0; }
+    GLuint getFramebufferId() const                 { return fboId; }
+    int getWidth() const                            { return width; }
+    int getHeight() const                           { return height; }
+    const std::string& getDescription() const       { return description; }    // e.g. "EGL 1.5 surfaceless"
+
+private:
+    HeadlessContext(const HeadlessContext& rhs);    // no implementation
+    bool createFramebuffer();
+
+    void* display;                                  // EGLDisplay
+    void* context;                                  // EGLContext
+    void* surface;                                  // EGLSurface, 1x1 pbuffer if surfaceless is not supported
+    GLuint fboId;
+    GLuint colorId;                                 // renderbuffers attached to fboId
+    GLuint depthId;
+    int width;
+    int height;
+    std::string description;
+};
+
+#endif
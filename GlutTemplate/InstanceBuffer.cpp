@@ -0,0 +1,441 @@
+///////////////////////////////////////////////////////////////////////////////
+// InstanceBuffer.cpp
+// ==================
+// growable GPU buffer of fixed-size per-instance records
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include "InstanceBuffer.h"
+#include "vbo.h"
+#include "BufferRegistry.h"
+
+// minimum number of records in storage
+const int MIN_CAPACITY = 256;
+
+// above this number of ranges, pack them into the stream buffer instead of glBufferSubData per range
+const int MAX_SUBDATA_RANGES = 8;
+
+// records array for copyRecords()
+struct CopySource
+{
+    const char* records;
+    int stride;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// WriteFunc copying records from CPU array
+///////////////////////////////////////////////////////////////////////////////
+static void copyRecords(void* dst, int first, int count, const void* userData)
+{
+    const CopySource* source = (const CopySource*)userData;
+    memcpy(dst, source->records + first * source->stride, count * source->stride);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+InstanceBuffer::InstanceBuffer(int stride, GLenum usage) : id(0), usage(usage), stride(stride),
+                                                           count(0), capacity(0), bytesCopied(0),
+                                                           bytesUploaded(0), reallocCount(0), uploadCalls(0),
+                                                           streamId(0), streamSize(0)
+{
+}
+InstanceBuffer::~InstanceBuffer()
+{
+    // the buffer must be released by release() while RC is still open
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate empty storage for the given number of records
+///////////////////////////////////////////////////////////////////////////////
+bool InstanceBuffer::init(int capacity)
+{
+    release();
+
+    if(capacity < MIN_CAPACITY)
+        capacity = MIN_CAPACITY;
+
+    id = createVBO(0, capacity * stride, GL_ARRAY_BUFFER, usage, "InstanceBuffer");
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if(!id)
+        return false;
+
+    this->capacity = capacity;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete the buffer object
+///////////////////////////////////////////////////////////////////////////////
+void InstanceBuffer::release()
+{
+    if(id)
+        deleteVBO(id);
+    if(streamId)
+        deleteVBO(streamId);
+    id = streamId = 0;
+    count = capacity = streamSize = 0;
+    std::vector<char>().swap(staging);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append records at the end, the storage grows if needed
+// It returns -1 if the storage cannot grow; nothing is added then.
+///////////////////////////////////////////////////////////////////////////////
+int InstanceBuffer::add(const void* data, int count)
+{
+    int first = this->count;
+    if(!resize(first + count))
+        return -1;
+    if(data)
+        update(first, count, data);
+    return first;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove a record by moving the last record into its slot
+// It returns the previous index of the moved record, so the caller can remap
+// the handle. It returns -1 if no record was moved (the last one removed).
+///////////////////////////////////////////////////////////////////////////////
+int InstanceBuffer::remove(int index)
+{
+    if(index < 0 || index >= count)
+        return -1;
+
+    int last = count - 1;
+    int moved = -1;
+    if(index != last)
+    {
+        // same buffer can be bound to read and write targets as long as
+        // source and destination ranges do not overlap
+        glBindBuffer(GL_COPY_READ_BUFFER, id);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, last * stride, index * stride, stride);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        bytesCopied += stride;
+        moved = last;
+    }
+    --count;
+
+    // shrink with hysteresis so add/remove at the boundary does not thrash
+    if(count < capacity / 4)
+        compact();
+
+    return moved;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// change the number of records, grow the storage geometrically if needed
+// If the storage cannot grow, the number of records is not changed, so it
+// never exceeds the capacity, and it returns false.
+///////////////////////////////////////////////////////////////////////////////
+bool InstanceBuffer::resize(int count)
+{
+    if(count < 0)
+        count = 0;
+
+    if(count > capacity)
+    {
+        int newCapacity = capacity > MIN_CAPACITY ? capacity : MIN_CAPACITY;
+        while(newCapacity < count)
+            newCapacity *= 2;
+        if(!reallocate(newCapacity))
+        {
+            std::cout << "[InstanceBuffer::resize()] Failed to grow the storage to " << newCapacity
+                      << " records, keeping " << this->count << " of " << count << " records." << std::endl;
+            return false;
+        }
+    }
+    this->count = count;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy records from CPU memory
+///////////////////////////////////////////////////////////////////////////////
+void InstanceBuffer::update(int first, int count, const void* data)
+{
+    if(first < 0 || count <= 0 || first + count > this->count)
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, id);
+    glBufferSubData(GL_ARRAY_BUFFER, first * stride, count * stride, data);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    bytesUploaded += count * stride;
+    ++uploadCalls;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// upload the dirty ranges of the CPU records array (the whole array, not the
+// dirty part only) and clear the dirty set
+// A few ranges are sent with glBufferSubData() each. Many ranges are packed
+// into the stream buffer with one mapping and copied on GPU side, so the
+// driver neither transfers the clean gaps nor waits for the previous frame.
+///////////////////////////////////////////////////////////////////////////////
+void InstanceBuffer::upload(DirtyRanges& dirty, const void* records)
+{
+    const std::vector<DirtyRanges::Range>& ranges = dirty.coalesce();
+    if(ranges.empty() || !records)
+    {
+        dirty.clear();
+        return;
+    }
+
+    const char* src = (const char*)records;
+    if((int)ranges.size() <= MAX_SUBDATA_RANGES)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, id);
+        for(size_t i = 0; i < ranges.size(); ++i)
+        {
+            int first = ranges[i].first;
+            int last = std::min(first + ranges[i].count, count);
+            if(first >= last)
+                continue;
+
+            glBufferSubData(GL_ARRAY_BUFFER, first * stride, (last - first) * stride, src + first * stride);
+            bytesUploaded += (last - first) * stride;
+            ++uploadCalls;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else
+    {
+        CopySource source = { src, stride };
+        if(!uploadStream(ranges, copyRecords, &source))
+            return;
+    }
+    dirty.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// make sure the storage can hold the given number of records
+///////////////////////////////////////////////////////////////////////////////
+bool InstanceBuffer::reserve(int capacity)
+{
+    if(capacity > this->capacity)
+        return reallocate(capacity);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// release unused storage if less than a quarter is used
+///////////////////////////////////////////////////////////////////////////////
+void InstanceBuffer::compact()
+{
+    if(capacity <= MIN_CAPACITY || count >= capacity / 4)
+        return;
+
+    int newCapacity = count * 2;
+    if(newCapacity < MIN_CAPACITY)
+        newCapacity = MIN_CAPACITY;
+    reallocate(newCapacity);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// reset per-frame statistics
+///////////////////////////////////////////////////////////////////////////////
+void InstanceBuffer::resetStats()
+{
+    bytesCopied = bytesUploaded = reallocCount = uploadCalls = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// move live records to a new buffer object on GPU side
+// It returns false if the new buffer object cannot be created; the old one is
+// kept then. createVBO() does not read the size back, so GL_OUT_OF_MEMORY is
+// checked here; reallocation is rare, so the query does not stall every frame.
+///////////////////////////////////////////////////////////////////////////////
+bool InstanceBuffer::reallocate(int newCapacity)
+{
+    GLuint newId = createVBO(0, newCapacity * stride, GL_COPY_WRITE_BUFFER, usage, "InstanceBuffer");
+    if(newId && glGetError() == GL_OUT_OF_MEMORY)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        deleteVBO(newId);
+        newId = 0;
+    }
+    if(!newId)
+        return false;
+
+    if(id && count > 0)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, id);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, count * stride);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        bytesCopied += count * stride;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if(id)
+        deleteVBO(id);
+    id = newId;
+    capacity = newCapacity;
+    ++reallocCount;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// generate the dirty records with the write function and upload them
+// A few ranges are written into a CPU staging block and sent with
+// glBufferSubData() each; many ranges go through the stream buffer. The
+// ranges stay dirty if the stream buffer cannot be mapped, so they are
+// written again with the next upload.
+///////////////////////////////////////////////////////////////////////////////
+void InstanceBuffer::upload(DirtyRanges& dirty, WriteFunc write, const void* userData)
+{
+    const std::vector<DirtyRanges::Range>& ranges = dirty.coalesce();
+    if(ranges.empty() || !write)
+    {
+        dirty.clear();
+        return;
+    }
+
+    if((int)ranges.size() <= MAX_SUBDATA_RANGES)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, id);
+        for(size_t i = 0; i < ranges.size(); ++i)
+        {
+            int first = ranges[i].first;
+            int last = std::min(first + ranges[i].count, count);
+            if(first >= last)
+                continue;
+
+            int size = (last - first) * stride;
+            if((int)staging.size() < size)
+                staging.resize(size);
+            write(&staging[0], first, last - first, userData);
+            glBufferSubData(GL_ARRAY_BUFFER, first * stride, size, &staging[0]);
+            bytesUploaded += size;
+            ++uploadCalls;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else if(!uploadStream(ranges, write, userData))
+    {
+        return;
+    }
+    dirty.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the ranges packed into the stream buffer, then copy each one to its
+// place in the storage on GPU side
+// The stream buffer is mapped with GL_MAP_INVALIDATE_BUFFER_BIT, so the
+// driver gives it fresh memory while the previous contents are still being
+// copied, and the CPU never writes to memory the GPU may be reading. The
+// copies are queued like draw calls. It returns false if the stream buffer
+// cannot be created or mapped; nothing is copied then.
+///////////////////////////////////////////////////////////////////////////////
+bool InstanceBuffer::uploadStream(const std::vector<DirtyRanges::Range>& ranges, WriteFunc write, const void* userData)
+{
+    int total = 0;
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        int last = std::min(ranges[i].first + ranges[i].count, count);
+        if(ranges[i].first < last)
+            total += (last - ranges[i].first) * stride;
+    }
+    if(total == 0)
+        return true;
+
+    if(!streamId)
+    {
+        streamSize = std::max(total, MIN_CAPACITY * stride);
+        streamId = createVBO(0, streamSize, GL_COPY_READ_BUFFER, GL_STREAM_DRAW, "InstanceBuffer stream");
+        if(!streamId)
+            return false;
+    }
+    else
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, streamId);
+        if(streamSize < total)
+        {
+            while(streamSize < total)
+                streamSize *= 2;
+            glBufferData(GL_COPY_READ_BUFFER, streamSize, 0, GL_STREAM_DRAW);
+            BufferRegistry::resize(streamId, streamSize);
+        }
+    }
+
+    char* dst = (char*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, total,
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if(!dst)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return false;
+    }
+
+    int offset = 0;
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        int first = ranges[i].first;
+        int last = std::min(first + ranges[i].count, count);
+        if(first >= last)
+            continue;
+
+        write(dst + offset, first, last - first, userData);
+        offset += (last - first) * stride;
+    }
+
+    // the contents are undefined if the store was lost while mapped
+    if(!glUnmapBuffer(GL_COPY_READ_BUFFER))
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return false;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+    offset = 0;
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        int first = ranges[i].first;
+        int last = std::min(first + ranges[i].count, count);
+        if(first >= last)
+            continue;
+
+        int size = (last - first) * stride;
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, first * stride, size);
+        offset += size;
+        ++uploadCalls;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    bytesUploaded += total;
+    return true;
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// InstanceBuffer.h
+// ================
+// growable GPU buffer of fixed-size per-instance records
+//
+// The storage grows geometrically; the existing records are moved to the new
+// buffer object with glCopyBufferSubData(), so nothing is re-uploaded from
+// CPU memory. Removing a record fills the hole by moving the last record into
+// it (swap-and-pop), which is also done on GPU side. The storage is shrunk when
+// it becomes mostly empty.
+// Modified records can be uploaded partially with upload(); only the dirty
+// ranges are transferred, using glBufferSubData() for a few ranges. Many
+// ranges are packed into a separate stream buffer, which is invalidated on
+// every map, and copied into place on GPU side, so the upload never waits for
+// the draw calls of the previous frame reading the storage. The records can
+// also be generated by a write function, e.g. converting the simulation state
+// into instance matrices, into a CPU staging block or the mapped stream buffer.
+// If the stream buffer cannot be mapped, the ranges are kept dirty.
+// If a new buffer object cannot be created, the storage and the number of
+// records stay as they were, and resize()/reserve() return false.
+// The number of bytes moved on GPU side and uploaded from CPU are accumulated
+// until resetStats() is called, normally once per frame.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef INSTANCE_BUFFER_H
+#define INSTANCE_BUFFER_H
+
+#include <vector>
+#include "glExtension.h"
+#include "DirtyRanges.h"
+
+class InstanceBuffer
+{
+public:
+    // write count records starting at record first into dst (staging or mapped memory)
+    typedef void (*WriteFunc)(void* dst, int first, int count, const void* userData);
+
+    InstanceBuffer(int stride, GLenum usage=GL_DYNAMIC_DRAW);
+    ~InstanceBuffer();
+
+    bool init(int capacity);                        // allocate storage, must be called after RC is open
+    void release();                                 // delete buffer object
+
+    int  add(const void* data, int count=1);        // append records, return index of the first one or -1
+    int  remove(int index);                         // swap-and-pop, return old index of moved record or -1
+    bool resize(int count);                         // change number of records, new records are undefined
+    void update(int first, int count, const void* data);
+    void upload(DirtyRanges& dirty, const void* records);   // copy dirty ranges of records array
+    void upload(DirtyRanges& dirty, WriteFunc write, const void* userData); // generate dirty ranges in place
+    bool reserve(int capacity);                     // grow storage if smaller than capacity
+    void compact();                                 // shrink storage if mostly empty
+
+    GLuint getId() const                { return id; }
+    int getCount() const                { return count; }
+    int getCapacity() const             { return capacity; }
+    int getStride() const               { return stride; }
+
+    // statistics since last resetStats()
+    void resetStats();
+    int getBytesCopied() const          { return bytesCopied; }
+    int getBytesUploaded() const        { return bytesUploaded; }
+    int getReallocCount() const         { return reallocCount; }
+    int getUploadCalls() const          { return uploadCalls; }
+
+private:
+    InstanceBuffer(const InstanceBuffer& rhs);      // no implementation
+    bool reallocate(int newCapacity);
+    bool uploadStream(const std::vector<DirtyRanges::Range>& ranges, WriteFunc write, const void* userData);
+
+    GLuint id;
+    GLenum usage;
+    int stride;                                     // bytes per record
+    int count;                                      // number of live records
+    int capacity;                                   // number of records in storage
+    int bytesCopied;                                // GPU-side copies
+    int bytesUploaded;                              // CPU to GPU transfers
+    int reallocCount;
+    int uploadCalls;                                // glBufferSubData or copy calls
+    GLuint streamId;                                // packed ranges to copy from
+    int streamSize;                                 // bytes
+    std::vector<char> staging;                      // records generated for glBufferSubData
+};
+
+#endif
@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////////
+// LabelRenderer.cpp
+// =================
+// billboarded 3D text labels drawn as instanced glyph quads
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include "LabelRenderer.h"
+#include "Font8x13.h"
+#include "vbo.h"
+#include "BufferRegistry.h"
+#include "shader.h"
+
+// gl_Vertex is the corner of unit quad, the other attributes advance per glyph
+static const char* labelVsSource = R"(
+#version 120
+attribute vec4 glyphPosition;   // xyz: label anchor, w: glyph offset from center
+attribute vec2 glyphTexCoord;   // bottom-left of glyph in atlas
+attribute vec4 glyphColor;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec2 glyphSize;         // glyph width and height in world units
+uniform vec2 texGlyphSize;      // glyph width and height in atlas
+varying vec2 texCoord;
+varying vec4 color;
+
+void main()
+{
+    // offset in eye space keeps the quad facing the camera
+    vec4 eye = viewMatrix * vec4(glyphPosition.xyz, 1.0);
+    eye.xy += vec2(glyphPosition.w + gl_Vertex.x, gl_Vertex.y) * glyphSize;
+    gl_Position = projectionMatrix * eye;
+    texCoord = glyphTexCoord + gl_Vertex.xy * texGlyphSize;
+    color = glyphColor;
+}
+)";
+
+static const char* labelFsSource = R"(
+#version 120
+uniform sampler2D atlas;
+varying vec2 texCoord;
+varying vec4 color;
+
+void main()
+{
+    gl_FragColor = vec4(color.rgb, color.a * texture2D(atlas, texCoord).a);
+}
+)";
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+LabelRenderer::LabelRenderer() : camera(0), glyphHeight(0.1f), fadeStart(5), fadeEnd(10), maxLabels(2000),
+                                 labelCount(0), candidateCount(0), texId(0), quadVboId(0), glyphVboId(0),
+                                 glyphVboSize(0), progId(0), attribPosition(-1), attribTexCoord(-1),
+                                 attribColor(-1), uniformViewMatrix(-1), uniformProjectionMatrix(-1),
+                                 uniformGlyphSize(-1), uniformTexGlyphSize(-1), cameraVersion(0)
+{
+}
+LabelRenderer::~LabelRenderer()
+{
+    // the buffers must be released by release() while RC is still open
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create shader program, unit quad and instance buffer
+///////////////////////////////////////////////////////////////////////////////
+bool LabelRenderer::init(const TextRenderer& font)
+{
+    release();
+
+    texId = font.getTextureId();
+    progId = createShaderProgram(labelVsSource, labelFsSource);
+    if(!texId || !progId)
+    {
+        release();
+        return false;
+    }
+
+    attribPosition          = glGetAttribLocation(progId, "glyphPosition");
+    attribTexCoord          = glGetAttribLocation(progId, "glyphTexCoord");
+    attribColor             = glGetAttribLocation(progId, "glyphColor");
+    uniformViewMatrix       = glGetUniformLocation(progId, "viewMatrix");
+    uniformProjectionMatrix = glGetUniformLocation(progId, "projectionMatrix");
+    uniformGlyphSize        = glGetUniformLocation(progId, "glyphSize");
+    uniformTexGlyphSize     = glGetUniformLocation(progId, "texGlyphSize");
+
+    glUseProgram(progId);
+    glUniform1i(glGetUniformLocation(progId, "atlas"), 0);
+    glUniform2f(uniformTexGlyphSize, (float)FONT_WIDTH / TextRenderer::ATLAS_WIDTH,
+                (float)FONT_HEIGHT / TextRenderer::ATLAS_HEIGHT);
+    glUseProgram(0);
+
+    // corners of unit quad as triangle strip
+    const float quad[] = { 0, 0,  1, 0,  0, 1,  1, 1 };
+    quadVboId = createVBO(quad, sizeof(quad), GL_ARRAY_BUFFER, GL_STATIC_DRAW, "LabelRenderer quad");
+    glyphVboSize = 4096 * sizeof(Glyph);
+    glyphVboId = createVBO(0, glyphVboSize, GL_ARRAY_BUFFER, GL_STREAM_DRAW, "LabelRenderer glyphs");
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if(!quadVboId || !glyphVboId || attribPosition < 0 || attribTexCoord < 0 || attribColor < 0)
+    {
+        release();
+        return false;
+    }
+
+    cameraVersion = 0;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete buffers and program; the atlas belongs to TextRenderer
+///////////////////////////////////////////////////////////////////////////////
+void LabelRenderer::release()
+{
+    deleteVBO(quadVboId);
+    deleteVBO(glyphVboId);
+    quadVboId = glyphVboId = 0;
+    glyphVboSize = 0;
+    deleteShaderProgram(progId);
+    progId = 0;
+    texId = 0;
+    glyphs.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start labels of a new frame seen from the camera
+///////////////////////////////////////////////////////////////////////////////
+void LabelRenderer::begin(const Camera& camera)
+{
+    this->camera = &camera;
+    eye = camera.getPosition();
+    glyphs.clear();
+    labelCount = 0;
+    candidateCount = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the label positions worth drawing and return their indices
+// A position is kept if the sphere of the radius around it intersects the
+// view frustum and it is closer than the fade-out distance. If more than
+// maxLabels remain, only the nearest ones are returned, sorted near to far.
+///////////////////////////////////////////////////////////////////////////////
+int LabelRenderer::select(const Vec3SoA& positions, int count, float radius, std::vector<int>& indices)
+{
+    indices.clear();
+    candidateCount += count;
+    if(!camera || count <= 0)
+        return 0;
+
+    Vec4 planes[6];
+    camera->getFrustumPlanes(planes);
+
+    radii.assign(count, radius);
+    visible.resize(count);
+    if(batchCullSpheres(planes, 6, positions, &radii[0], &visible[0], count) == 0)
+        return 0;
+
+    float maxDistance2 = fadeEnd * fadeEnd;
+    nearest.clear();
+    for(int i = 0; i < count; ++i)
+    {
+        if(!visible[i])
+            continue;
+
+        float dx = positions.x[i] - eye.x;
+        float dy = positions.y[i] - eye.y;
+        float dz = positions.z[i] - eye.z;
+        float d2 = dx * dx + dy * dy + dz * dz;
+        if(d2 < maxDistance2)
+            nearest.push_back(std::make_pair(d2, i));
+    }
+
+    int room = maxLabels - labelCount;
+    if(room < 0)
+        room = 0;
+    if((int)nearest.size() > room)
+    {
+        std::nth_element(nearest.begin(), nearest.begin() + room, nearest.end());
+        nearest.resize(room);
+    }
+    std::sort(nearest.begin(), nearest.end());
+
+    for(size_t i = 0; i < nearest.size(); ++i)
+        indices.push_back(nearest[i].second);
+    return (int)indices.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append a label centered above the position
+// The alpha fades linearly from fadeStart to fadeEnd; farther labels are
+// dropped.
+///////////////////////////////////////////////////////////////////////////////
+void LabelRenderer::addLabel(const Vec3& position, const char* text, const float color[4])
+{
+    if(labelCount >= maxLabels)
+        return;
+
+    float distance = length(position - eye);
+    if(distance >= fadeEnd)
+        return;
+
+    float fade = 1.0f;
+    if(distance > fadeStart && fadeEnd > fadeStart)
+        fade = (fadeEnd - distance) / (fadeEnd - fadeStart);
+
+    unsigned char rgba[4];
+    for(int i = 0; i < 3; ++i)
+        rgba[i] = (unsigned char)(color[i] * 255.0f + 0.5f);
+    rgba[3] = (unsigned char)(color[3] * fade * 255.0f + 0.5f);
+
+    int textLength = 0;
+    while(text[textLength])
+        ++textLength;
+
+    Glyph g;
+    g.x = position.x;
+    g.y = position.y;
+    g.z = position.z;
+    for(int i = 0; i < 4; ++i)
+        g.color[i] = rgba[i];
+
+    float offset = -0.5f * textLength;
+    for(int i = 0; i < textLength; ++i, offset += 1.0f)
+    {
+        if(text[i] == ' ')
+            continue;
+
+        float s1, t1;
+        TextRenderer::getGlyphTexCoords(text[i], g.s, g.t, s1, t1);
+        g.offset = offset;
+        glyphs.push_back(g);
+    }
+    ++labelCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw all glyphs of the frame as instances of one quad
+// Depth is tested but not written, so labels are hidden by objects in front
+// but do not hide each other.
+///////////////////////////////////////////////////////////////////////////////
+void LabelRenderer::draw()
+{
+    if(!progId || !camera || glyphs.empty())
+        return;
+
+    int dataSize = (int)(glyphs.size() * sizeof(Glyph));
+    glBindBuffer(GL_ARRAY_BUFFER, glyphVboId);
+    while(glyphVboSize < dataSize)
+        glyphVboSize *= 2;
+    glBufferData(GL_ARRAY_BUFFER, glyphVboSize, 0, GL_STREAM_DRAW);    // orphan previous frame
+    BufferRegistry::resize(glyphVboId, glyphVboSize);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, &glyphs[0]);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_POLYGON_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_CULL_FACE);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texId);
+
+    glUseProgram(progId);
+    if(cameraVersion != camera->getVersion())
+    {
+        glUniformMatrix4fv(uniformViewMatrix, 1, GL_FALSE, camera->getViewMatrix().get());
+        glUniformMatrix4fv(uniformProjectionMatrix, 1, GL_FALSE, camera->getProjectionMatrix().get());
+        cameraVersion = camera->getVersion();
+    }
+    glUniform2f(uniformGlyphSize, glyphHeight * FONT_WIDTH / FONT_HEIGHT, glyphHeight);
+
+    // per-glyph attributes
+    glEnableVertexAttribArray(attribPosition);
+    glEnableVertexAttribArray(attribTexCoord);
+    glEnableVertexAttribArray(attribColor);
+    glVertexAttribPointer(attribPosition, 4, GL_FLOAT, GL_FALSE, sizeof(Glyph), 0);
+    glVertexAttribPointer(attribTexCoord, 2, GL_FLOAT, GL_FALSE, sizeof(Glyph), (void*)(4 * sizeof(float)));
+    glVertexAttribPointer(attribColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Glyph), (void*)(6 * sizeof(float)));
+    glVertexAttribDivisor(attribPosition, 1);
+    glVertexAttribDivisor(attribTexCoord, 1);
+    glVertexAttribDivisor(attribColor, 1);
+
+    // quad corners
+    glBindBuffer(GL_ARRAY_BUFFER, quadVboId);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, 0);
+
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)glyphs.size());
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glVertexAttribDivisor(attribPosition, 0);
+    glVertexAttribDivisor(attribTexCoord, 0);
+    glVertexAttribDivisor(attribColor, 0);
+    glDisableVertexAttribArray(attribPosition);
+    glDisableVertexAttribArray(attribTexCoord);
+    glDisableVertexAttribArray(attribColor);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopAttrib();
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// LabelRenderer.h
+// ===============
+// billboarded 3D text labels drawn as instanced glyph quads
+//
+// Labels are built every frame in 2 phases. select() culls the candidate
+// positions against the view frustum (SIMD sphere test) and the fade-out
+// distance, and keeps at most maxLabels nearest ones, so the caller formats
+// text only for the labels that will be drawn. addLabel() then appends one
+// instance per character; its alpha fades out between the fade distances.
+// draw() streams the instances into a buffer and renders all labels of the
+// frame with a single glDrawArraysInstanced() of one quad. The vertex shader
+// places each glyph in eye space, so the labels always face the camera.
+//
+// The glyphs are sampled from the atlas texture of TextRenderer.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef LABEL_RENDERER_H
+#define LABEL_RENDERER_H
+
+#include <vector>
+#include <utility>
+#include "glExtension.h"
+#include "Camera.h"
+#include "TextRenderer.h"
+
+class LabelRenderer
+{
+public:
+    LabelRenderer();
+    ~LabelRenderer();
+
+    bool init(const TextRenderer& font);            // create shader and buffers, must be called after RC is open
+    void release();
+
+    void setGlyphHeight(float height)               { glyphHeight = height; }   // in world units
+    void setFadeDistance(float start, float end)    { fadeStart = start; fadeEnd = end; }
+    void setMaxLabels(int count)                    { maxLabels = count; }
+
+    void begin(const Camera& camera);               // start a new frame, remove previous labels
+    int  select(const Vec3SoA& positions, int count, float radius, std::vector<int>& indices);
+    void addLabel(const Vec3& position, const char* text, const float color[4]);
+    void draw();                                    // draw all labels of the frame in one call
+
+    int getLabelCount() const                       { return labelCount; }
+    int getGlyphCount() const                       { return (int)glyphs.size(); }
+    int getCandidateCount() const                   { return candidateCount; }  // positions passed to select()
+    bool isInitialized() const                      { return progId != 0; }
+
+private:
+    LabelRenderer(const LabelRenderer& rhs);        // no implementation
+
+    // per-glyph instance
+    struct Glyph
+    {
+        float x, y, z;                              // label anchor, bottom center
+        float offset;                               // left edge of glyph in glyph widths from center
+        float s, t;                                 // bottom-left of glyph in atlas
+        unsigned char color[4];
+    };
+
+    std::vector<Glyph> glyphs;
+    std::vector<float> radii;                       // scratch for select()
+    std::vector<unsigned char> visible;
+    std::vector<std::pair<float, int> > nearest;    // squared distance and index
+
+    const Camera* camera;
+    Vec3 eye;
+    float glyphHeight;
+    float fadeStart;
+    float fadeEnd;
+    int maxLabels;
+    int labelCount;
+    int candidateCount;
+
+    GLuint texId;                                   // atlas, owned by TextRenderer
+    GLuint quadVboId;
+    GLuint glyphVboId;
+    int glyphVboSize;
+    GLuint progId;
+    GLint attribPosition;
+    GLint attribTexCoord;
+    GLint attribColor;
+    GLint uniformViewMatrix;
+    GLint uniformProjectionMatrix;
+    GLint uniformGlyphSize;
+    GLint uniformTexGlyphSize;
+    unsigned int cameraVersion;                     // camera version of the uploaded matrices
+};
+
+#endif
@@ -0,0 +1,321 @@
+///////////////////////////////////////////////////////////////////////////////
+// MicroBench.cpp
+// ==============
+// microbenchmark of the CPU kernels: trackball functions, quaternion
+// composition, instance matrix packing, transforms and culling
+//
+// Each kernel is timed with working sets sized to fit in L1, L2 and L3, and
+// one much larger than L3 (DRAM). The time is the best of several samples in
+// nanoseconds per element. The batch kernels run in a scalar and a SIMD build
+// (see MicroBench.h).
+// The results are compared with a baseline file written by an earlier run
+// with --save-baseline on the same machine. If any result is slower than its
+// baseline by more than the tolerance, the program returns 1, so a build
+// script (make microbench-check) fails.
+//
+// usage: microbench [--baseline FILE] [--save-baseline] [--tolerance 0.25]
+//                   [--time MS] [--filter NAME]
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include "MicroBench.h"
+
+namespace
+{
+    const int LEVEL_COUNT = 4;
+    const char* const LEVEL_NAMES[LEVEL_COUNT] = { "L1", "L2", "L3", "DRAM" };
+    const long long DEFAULT_CACHE_SIZES[3] = { 32 << 10, 1 << 20, 16 << 20 };
+    const long long MAX_L3_BYTES = 32 << 20;        // VMs may report the whole L3 of the host
+    const long long DRAM_BYTES = 256 << 20;
+    const int SAMPLES = 5;                          // best of
+    const char* const BASELINE_FILE = "microbench_baseline.txt";
+
+    struct Result
+    {
+        std::string kernel;
+        std::string variant;
+        double ns[LEVEL_COUNT];                     // per element
+    };
+
+    struct Baseline
+    {
+        std::string kernel;
+        std::string variant;
+        std::string level;
+        double ns;
+    };
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return time in seconds
+///////////////////////////////////////////////////////////////////////////////
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// working set in bytes per level: half of each cache, so the arrays stay in
+// it with room for the rest, and DRAM_BYTES for memory
+///////////////////////////////////////////////////////////////////////////////
+static void getWorkingSets(long long sizes[LEVEL_COUNT])
+{
+    long long caches[3] = { DEFAULT_CACHE_SIZES[0], DEFAULT_CACHE_SIZES[1], DEFAULT_CACHE_SIZES[2] };
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+    long values[3] = { sysconf(_SC_LEVEL1_DCACHE_SIZE), sysconf(_SC_LEVEL2_CACHE_SIZE), sysconf(_SC_LEVEL3_CACHE_SIZE) };
+    for(int i = 0; i < 3; ++i)
+    {
+        if(values[i] > 0)
+            caches[i] = values[i];
+    }
+#endif
+    sizes[0] = caches[0] / 2;
+    sizes[1] = caches[1] / 2;
+    sizes[2] = std::min(caches[2] / 2, MAX_L3_BYTES);
+    sizes[3] = DRAM_BYTES;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// time a kernel on count elements, return ns per element
+// The kernel runs repeatedly for about seconds / SAMPLES per sample, and the
+// fastest sample is taken; slower ones are disturbed by the system.
+///////////////////////////////////////////////////////////////////////////////
+static double measure(const MicroKernel& kernel, float* pool, int count, double seconds)
+{
+    kernel.init(pool, count);
+    kernel.run(pool, count);                        // warm caches and page in outputs
+
+    double best = 1e30;
+    for(int s = 0; s < SAMPLES; ++s)
+    {
+        int runs = 0;
+        double start = now();
+        double elapsed = 0;
+        do
+        {
+            kernel.run(pool, count);
+            ++runs;
+            elapsed = now() - start;
+        }
+        while(elapsed < seconds / SAMPLES);
+        best = std::min(best, elapsed / runs / count);
+    }
+    return best * 1e9;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// time the kernels of a table at all levels
+///////////////////////////////////////////////////////////////////////////////
+static void runKernels(const MicroKernel* kernels, int kernelCount, const char* variant, float* pool,
+                       const long long workingSets[LEVEL_COUNT], double seconds, const std::string& filter,
+                       std::vector<Result>& results)
+{
+    for(int k = 0; k < kernelCount; ++k)
+    {
+        if(!filter.empty() && !strstr(kernels[k].name, filter.c_str()))
+            continue;
+
+        Result result;
+        result.kernel = kernels[k].name;
+        result.variant = variant;
+        for(int level = 0; level < LEVEL_COUNT; ++level)
+        {
+            int count = (int)(workingSets[level] / kernels[k].bytesPerElement);
+            result.ns[level] = measure(kernels[k], pool, count, seconds);
+        }
+        results.push_back(result);
+
+        char line[256];
+        snprintf(line, sizeof(line), "%-22s %-7s", result.kernel.c_str(), variant);
+        std::cout << line;
+        for(int level = 0; level < LEVEL_COUNT; ++level)
+        {
+            snprintf(line, sizeof(line), " %9.3f", result.ns[level]);
+            std::cout << line;
+        }
+        std::cout << std::endl;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read "kernel variant level ns" lines, # starts a comment
+///////////////////////////////////////////////////////////////////////////////
+static bool loadBaseline(const std::string& fileName, std::vector<Baseline>& baseline)
+{
+    std::ifstream file(fileName.c_str());
+    if(!file)
+        return false;
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+        std::stringstream ss(line);
+        Baseline b;
+        if(ss >> b.kernel >> b.variant >> b.level >> b.ns)
+            baseline.push_back(b);
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the results as the new baseline
+///////////////////////////////////////////////////////////////////////////////
+static bool saveBaseline(const std::string& fileName, const std::vector<Result>& results)
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+    {
+        std::cout << "[saveBaseline()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    file << "# microbench baseline: kernel variant level ns_per_element\n";
+    char line[256];
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        for(int level = 0; level < LEVEL_COUNT; ++level)
+        {
+            snprintf(line, sizeof(line), "%s %s %s %.4f\n", results[i].kernel.c_str(), results[i].variant.c_str(),
+                     LEVEL_NAMES[level], results[i].ns[level]);
+            file << line;
+        }
+    }
+    std::cout << "Saved baseline to " << fileName << std::endl;
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print results slower than baseline * (1 + tolerance), return their count
+///////////////////////////////////////////////////////////////////////////////
+static int compareBaseline(const std::vector<Result>& results, const std::vector<Baseline>& baseline, double tolerance)
+{
+    int slower = 0;
+    int compared = 0;
+    char line[256];
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        for(int level = 0; level < LEVEL_COUNT; ++level)
+        {
+            for(size_t b = 0; b < baseline.size(); ++b)
+            {
+                const Baseline& base = baseline[b];
+                if(base.kernel != results[i].kernel || base.variant != results[i].variant || base.level != LEVEL_NAMES[level])
+                    continue;
+
+                ++compared;
+                double ns = results[i].ns[level];
+                if(ns > base.ns * (1.0 + tolerance))
+                {
+                    snprintf(line, sizeof(line), "SLOWER: %s %s %s %.3f ns, baseline %.3f ns (+%.0f%%)",
+                             base.kernel.c_str(), base.variant.c_str(), base.level.c_str(), ns, base.ns,
+                             (ns / base.ns - 1.0) * 100.0);
+                    std::cout << line << std::endl;
+                    ++slower;
+                }
+                break;
+            }
+        }
+    }
+    std::cout << "Compared " << compared << " results with the baseline, " << slower
+              << " slower by more than " << (int)(tolerance * 100 + 0.5) << "%." << std::endl;
+    return slower;
+}
+
+
+
+int main(int argc, char** argv)
+{
+    std::string baselineFile = BASELINE_FILE;
+    std::string filter;
+    bool save = false;
+    double tolerance = 0.25;
+    double seconds = 0.1;                           // per kernel and level
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselineFile = argv[++i];
+        else if(strcmp(argv[i], "--save-baseline") == 0)
+            save = true;
+        else if(strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            tolerance = atof(argv[++i]);
+        else if(strcmp(argv[i], "--time") == 0 && i + 1 < argc)
+            seconds = atof(argv[++i]) * 0.001;
+        else if(strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else
+        {
+            std::cout << "usage: " << argv[0] << " [--baseline FILE] [--save-baseline] [--tolerance 0.25]"
+                      << " [--time MS] [--filter NAME]" << std::endl;
+            return 2;
+        }
+    }
+
+    long long workingSets[LEVEL_COUNT];
+    getWorkingSets(workingSets);
+    std::vector<float> pool((size_t)(workingSets[LEVEL_COUNT - 1] / sizeof(float)) + 1024);
+
+    std::cout << "SIMD: " << getSimdName() << ", working sets:";
+    for(int level = 0; level < LEVEL_COUNT; ++level)
+        std::cout << " " << LEVEL_NAMES[level] << " " << workingSets[level] / 1024 << " KB";
+    std::cout << std::endl;
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-22s %-7s %9s %9s %9s %9s  (ns/element)",
+             "kernel", "variant", "L1", "L2", "L3", "DRAM");
+    std::cout << line << std::endl;
+
+    std::vector<Result> results;
+    int count = 0;
+    const MicroKernel* kernels = getTrackballKernels(count);
+    runKernels(kernels, count, "scalar", &pool[0], workingSets, seconds, filter, results);
+    kernels = getScalarKernels(count);
+    runKernels(kernels, count, "scalar", &pool[0], workingSets, seconds, filter, results);
+    if(strcmp(getSimdName(), "scalar") != 0)
+    {
+        kernels = getSimdKernels(count);
+        runKernels(kernels, count, getSimdName(), &pool[0], workingSets, seconds, filter, results);
+    }
+
+    if(save)
+        return saveBaseline(baselineFile, results) ? 0 : 1;
+
+    std::vector<Baseline> baseline;
+    if(!loadBaseline(baselineFile, baseline))
+    {
+        std::cout << "No baseline " << baselineFile << ", run with --save-baseline to create it." << std::endl;
+        return 0;
+    }
+    return compareBaseline(results, baseline, tolerance) > 0 ? 1 : 0;
+}
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////
+// MicroBench.h
+// ============
+// kernels of the CPU microbenchmark (../bin/microbench, see MicroBench.cpp)
+//
+// A kernel processes count elements in arrays carved from one memory pool,
+// so the benchmark can size the working set to fit in L1, L2, L3 or DRAM.
+// bytesPerElement is the memory the kernel touches per element, inputs and
+// outputs together.
+// The batch kernels of VectorMath.h are defined once in MicroKernels.h and
+// compiled twice: with the SIMD path of the build (MicroKernelsSimd.cpp), and
+// with VECTORMATH_SCALAR (MicroKernelsScalar.cpp), so both variants are
+// measured by the same executable. The trackball.h functions have no SIMD
+// version; getTrackballKernels() returns them.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+struct MicroKernel
+{
+    const char* name;
+    int bytesPerElement;                            // working set per element
+    void (*init)(float* pool, int count);           // fill inputs, not timed
+    void (*run)(float* pool, int count);
+};
+
+// kernel tables, in the same order for both variants
+const MicroKernel* getScalarKernels(int& count);
+const MicroKernel* getSimdKernels(int& count);
+const MicroKernel* getTrackballKernels(int& count);
+const char* getSimdName();                          // "SSE", "AVX", "NEON" or "scalar"
+
+#endif
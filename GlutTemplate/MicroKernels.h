@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// MicroKernels.h
+// ==============
+// batch kernels of the microbenchmark, compiled once per variant
+//
+// This file has no include guard on purpose: MicroKernelsScalar.cpp and
+// MicroKernelsSimd.cpp include it after VectorMath.h, each inside its own
+// namespace, to get the same kernels built with scalar and SIMD code.
+// The arrays of a kernel are consecutive blocks of count floats in the pool;
+// array(pool, count, 3) is the 4th block.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+static float* array(float* pool, int count, int index)
+{
+    return pool + (size_t)count * index;
+}
+
+static Vec3SoA vec3Array(float* pool, int count, int index)
+{
+    return Vec3SoA(array(pool, count, index), array(pool, count, index + 1), array(pool, count, index + 2));
+}
+
+static QuatSoA quatArray(float* pool, int count, int index)
+{
+    return QuatSoA(array(pool, count, index), array(pool, count, index + 1),
+                   array(pool, count, index + 2), array(pool, count, index + 3));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill with reproducible pseudo-random values in [lo, hi)
+///////////////////////////////////////////////////////////////////////////////
+static void fillRandom(float* dst, int count, float lo, float hi, unsigned int seed)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        dst[i] = lo + (hi - lo) * (float)(seed >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+static void fillUnitQuats(const QuatSoA& q, int count, unsigned int seed)
+{
+    fillRandom(q.x, count, -1.0f, 1.0f, seed);
+    fillRandom(q.y, count, -1.0f, 1.0f, seed + 1);
+    fillRandom(q.z, count, -1.0f, 1.0f, seed + 2);
+    fillRandom(q.w, count, 0.1f, 1.0f, seed + 3);
+    for(int i = 0; i < count; ++i)
+    {
+        Quat n = normalize(Quat(q.x[i], q.y[i], q.z[i], q.w[i]));
+        q.x[i] = n.x;
+        q.y[i] = n.y;
+        q.z[i] = n.z;
+        q.w[i] = n.w;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// init functions; the layouts are in the comments of the run functions
+///////////////////////////////////////////////////////////////////////////////
+static void initPoints(float* pool, int count)
+{
+    for(int i = 0; i < 6; ++i)
+        fillRandom(array(pool, count, i), count, -10.0f, 10.0f, 100 + i);
+}
+
+static void initSpheres(float* pool, int count)
+{
+    for(int i = 0; i < 3; ++i)
+        fillRandom(array(pool, count, i), count, -10.0f, 10.0f, 200 + i);
+    fillRandom(array(pool, count, 3), count, 0.1f, 1.0f, 203);
+}
+
+static void initQuatPairs(float* pool, int count)
+{
+    fillUnitQuats(quatArray(pool, count, 0), count, 300);
+    fillUnitQuats(quatArray(pool, count, 4), count, 400);
+}
+
+static void initInstances(float* pool, int count)
+{
+    fillUnitQuats(quatArray(pool, count, 0), count, 500);
+    for(int i = 4; i < 7; ++i)
+        fillRandom(array(pool, count, i), count, -100.0f, 100.0f, 500 + i);
+    fillRandom(array(pool, count, 7), count, 0.5f, 2.0f, 507);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// kernels
+///////////////////////////////////////////////////////////////////////////////
+// a: 0-2, b: 3-5, out: 6-8
+static void runAdd(float* pool, int count)
+{
+    batchAdd(vec3Array(pool, count, 0), vec3Array(pool, count, 3), vec3Array(pool, count, 6), count);
+}
+
+// a: 0-2, b: 3-5, out: 6-8
+static void runCross(float* pool, int count)
+{
+    batchCross(vec3Array(pool, count, 0), vec3Array(pool, count, 3), vec3Array(pool, count, 6), count);
+}
+
+// a: 0-2, b: 3-5, out: 6
+static void runDot(float* pool, int count)
+{
+    batchDot(vec3Array(pool, count, 0), vec3Array(pool, count, 3), array(pool, count, 6), count);
+}
+
+// v: 0-2, out: 3-5
+static void runNormalize(float* pool, int count)
+{
+    batchNormalize(vec3Array(pool, count, 0), vec3Array(pool, count, 3), count);
+}
+
+// v: 0-2, out: 3-5
+static void runTransformPoints(float* pool, int count)
+{
+    static const Mat4 m = Mat4::translation(1.0f, 2.0f, 3.0f) *
+                          Mat4::rotation(normalize(Quat(0.2f, 0.4f, 0.1f, 0.9f)));
+    batchTransformPoints(m, vec3Array(pool, count, 0), vec3Array(pool, count, 3), count);
+}
+
+// centers: 0-2, radii: 3, visible: count bytes after
+static void runCullSpheres(float* pool, int count)
+{
+    // box of +-5 around the origin, about 1/8 of the spheres are visible
+    static const Vec4 planes[6] = { Vec4( 1, 0, 0, 5), Vec4(-1, 0, 0, 5),
+                                    Vec4( 0, 1, 0, 5), Vec4( 0,-1, 0, 5),
+                                    Vec4( 0, 0, 1, 5), Vec4( 0, 0,-1, 5) };
+    unsigned char* visible = (unsigned char*)array(pool, count, 4);
+    batchCullSpheres(planes, 6, vec3Array(pool, count, 0), array(pool, count, 3), visible, count);
+}
+
+// a: 0-3, b: 4-7, out: 8-11
+static void runCompose(float* pool, int count)
+{
+    batchCompose(quatArray(pool, count, 0), quatArray(pool, count, 4), quatArray(pool, count, 8), count);
+}
+
+// orientations: 0-3, positions: 4-6, scales: 7, 3x4 matrices: 12 floats per
+// element after, as packed into the instance buffer
+static void runQuatToMatrix(float* pool, int count)
+{
+    batchQuatToMatrix(quatArray(pool, count, 0), vec3Array(pool, count, 4), array(pool, count, 7),
+                      array(pool, count, 8), count);
+}
+
+
+
+static const MicroKernel KERNELS[] =
+{
+    { "batchAdd",             36, initPoints,    runAdd },
+    { "batchCross",           36, initPoints,    runCross },
+    { "batchDot",             28, initPoints,    runDot },
+    { "batchNormalize",       24, initPoints,    runNormalize },
+    { "batchTransformPoints", 24, initPoints,    runTransformPoints },
+    { "batchCullSpheres",     17, initSpheres,   runCullSpheres },
+    { "batchCompose",         48, initQuatPairs, runCompose },
+    { "batchQuatToMatrix",    80, initInstances, runQuatToMatrix },
+};
+static const int KERNEL_COUNT = sizeof(KERNELS) / sizeof(KERNELS[0]);
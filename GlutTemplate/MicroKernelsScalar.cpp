@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// MicroKernelsScalar.cpp
+// ======================
+// microbenchmark kernels built with the scalar code of VectorMath.h, and the
+// trackball.h functions, which are scalar only
+//
+// VectorMath.h is included inside a namespace, so its inline functions do not
+// clash with the SIMD versions used by the rest of the program. The standard
+// headers it needs are included before, at global scope.
+// Build this file with -fno-tree-vectorize, otherwise the compiler may turn
+// the scalar loops back into SIMD code.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstddef>
+#include "MicroBench.h"
+#include "trackball.h"
+
+#define VECTORMATH_SCALAR
+namespace scalarKernels
+{
+#include "VectorMath.h"
+#include "MicroKernels.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// trackball.h kernels, one call per element on AoS data as the trackball
+// functions take it
+///////////////////////////////////////////////////////////////////////////////
+static void initMouse(float* pool, int count)
+{
+    for(int i = 0; i < 4; ++i)
+        fillRandom(array(pool, count, i), count, -0.9f, 0.9f, 600 + i);
+}
+
+static void initQuatsAoS(float* pool, int count)
+{
+    fillRandom(pool, count * 8, -1.0f, 1.0f, 700);
+    for(int i = 0; i < count * 2; ++i)
+        normalize_quat(pool + i * 4);
+}
+
+// mouse positions p1x, p1y, p2x, p2y: 0-3, quaternions: 4 floats per element after
+static void runTrackball(float* pool, int count)
+{
+    const float* p1x = array(pool, count, 0);
+    const float* p1y = array(pool, count, 1);
+    const float* p2x = array(pool, count, 2);
+    const float* p2y = array(pool, count, 3);
+    float* q = array(pool, count, 4);
+    for(int i = 0; i < count; ++i)
+        trackball(q + i * 4, p1x[i], p1y[i], p2x[i], p2y[i]);
+}
+
+// quaternions a, b and dest: 4 floats per element each
+static void runAddQuats(float* pool, int count)
+{
+    float* a = pool;
+    float* b = pool + count * 4;
+    float* dest = pool + count * 8;
+    for(int i = 0; i < count; ++i)
+        add_quats(a + i * 4, b + i * 4, dest + i * 4);
+}
+
+// quaternions: 4 floats per element, 4x4 matrices: 16 floats per element after
+static void runBuildRotmatrix(float* pool, int count)
+{
+    float* q = pool;
+    float (*m)[4][4] = (float (*)[4][4])(pool + count * 4);
+    for(int i = 0; i < count; ++i)
+        build_rotmatrix(m[i], q + i * 4);
+}
+
+static const MicroKernel TRACKBALL_KERNELS[] =
+{
+    { "trackball",       32, initMouse,    runTrackball },
+    { "add_quats",       48, initQuatsAoS, runAddQuats },
+    { "build_rotmatrix", 80, initQuatsAoS, runBuildRotmatrix },
+};
+}
+
+
+
+const MicroKernel* getScalarKernels(int& count)
+{
+    count = scalarKernels::KERNEL_COUNT;
+    return scalarKernels::KERNELS;
+}
+
+const MicroKernel* getTrackballKernels(int& count)
+{
+    count = sizeof(scalarKernels::TRACKBALL_KERNELS) / sizeof(scalarKernels::TRACKBALL_KERNELS[0]);
+    return scalarKernels::TRACKBALL_KERNELS;
+}
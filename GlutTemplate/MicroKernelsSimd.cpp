@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////////////////////////
+// MicroKernelsSimd.cpp
+// ====================
+// microbenchmark kernels built with the SIMD path of VectorMath.h
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include "MicroBench.h"
+#include "VectorMath.h"
+
+namespace simdKernels
+{
+#include "MicroKernels.h"
+}
+
+
+
+const MicroKernel* getSimdKernels(int& count)
+{
+    count = simdKernels::KERNEL_COUNT;
+    return simdKernels::KERNELS;
+}
+
+const char* getSimdName()
+{
+    return simd::NAME;
+}
@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////////////////////
+// ParticleSystem.cpp
+// ==================
+// GPU particle fountain advanced with transform feedback
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <vector>
+#include "ParticleSystem.h"
+#include "vbo.h"
+#include "shader.h"
+
+// size of a particle record: position + life, velocity + seed
+const int PARTICLE_STRIDE = 8 * sizeof(float);
+
+// integrate particles; gl_Vertex is position and life, velocity is generic
+// attrib. The outputs are captured into the other buffer.
+static const char* updateVsSource = R"(
+#version 120
+attribute vec4 velocity;        // xyz: velocity, w: random seed
+uniform float dt;
+uniform float time;
+uniform vec3 emitter;
+uniform float lifeSpan;
+uniform float floorHeight;
+varying vec4 outPosition;
+varying vec4 outVelocity;
+
+float random(float x)
+{
+    return fract(sin(x * 12.9898 + time * 78.233) * 43758.5453);
+}
+
+void main()
+{
+    vec3 p = gl_Vertex.xyz;
+    vec3 v = velocity.xyz;
+    float life = gl_Vertex.w - dt;
+    float seed = velocity.w;
+
+    if(gl_Vertex.w < 0.0)
+    {
+        // not emitted yet, count the delay up to 0
+        life = min(gl_Vertex.w + dt, 0.0);
+    }
+    else if(life <= 0.0)
+    {
+        // respawn at emitter, shooting up in a narrow cone
+        float a = random(seed) * 6.2831853;
+        float r = random(seed + 1.0) * 0.8;
+        v = vec3(cos(a) * r, 4.0 + random(seed + 2.0) * 2.0, sin(a) * r);
+        p = emitter;
+        life = max(life + lifeSpan, 0.0);
+    }
+    else
+    {
+        v.y -= 9.8 * dt;
+        p += v * dt;
+        if(p.y < floorHeight)
+        {
+            p.y = floorHeight;
+            v.y *= -0.4;
+            v.xz *= 0.8;
+        }
+    }
+
+    outPosition = vec4(p, life);
+    outVelocity = vec4(v, seed);
+    gl_Position = vec4(p, 1.0);
+}
+)";
+
+// point sprite sized by distance, fading out with remaining life
+static const char* drawVsSource = R"(
+#version 120
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform float pointScale;
+uniform float lifeSpan;
+varying float fade;
+
+void main()
+{
+    vec4 eye = viewMatrix * vec4(gl_Vertex.xyz, 1.0);
+    gl_Position = projectionMatrix * eye;
+    gl_PointSize = pointScale / max(-eye.z, 0.1);
+    fade = clamp(gl_Vertex.w / lifeSpan, 0.0, 1.0);
+}
+)";
+
+static const char* drawFsSource = R"(
+#version 120
+varying float fade;
+
+void main()
+{
+    vec2 c = gl_PointCoord * 2.0 - 1.0;
+    float d = dot(c, c);
+    if(d > 1.0)
+        discard;
+    vec3 color = mix(vec3(1.0, 0.3, 0.1), vec3(1.0, 0.9, 0.5), fade);
+    gl_FragColor = vec4(color, fade * (1.0 - d));
+}
+)";
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() : current(0), count(0), time(0), lifeSpan(3), floorHeight(-0.5f),
+                                   updateProgId(0), velocityAttrib(-1), uniformDt(-1), uniformTime(-1),
+                                   uniformEmitter(-1), uniformLifeSpan(-1), uniformFloor(-1),
+                                   drawProgId(0), uniformViewMatrix(-1), uniformProjectionMatrix(-1),
+                                   uniformPointScale(-1), uniformDrawLifeSpan(-1), cameraVersion(0)
+{
+    vboIds[0] = vboIds[1] = 0;
+    emitter[0] = emitter[1] = emitter[2] = 0;
+}
+ParticleSystem::~ParticleSystem()
+{
+    // the buffers must be released by release() while RC is still open
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create the state buffers and shader programs
+// The particles start with emission delays spread over one life span, so
+// they are emitted continuously instead of all at once.
+///////////////////////////////////////////////////////////////////////////////
+bool ParticleSystem::init(int count)
+{
+    release();
+
+    const char* varyings[] = { "outPosition", "outVelocity" };
+    updateProgId = createShaderProgram(updateVsSource, 0, varyings, 2);
+    drawProgId = createShaderProgram(drawVsSource, drawFsSource);
+    if(!updateProgId || !drawProgId)
+    {
+        release();
+        return false;
+    }
+
+    velocityAttrib  = glGetAttribLocation(updateProgId, "velocity");
+    uniformDt       = glGetUniformLocation(updateProgId, "dt");
+    uniformTime     = glGetUniformLocation(updateProgId, "time");
+    uniformEmitter  = glGetUniformLocation(updateProgId, "emitter");
+    uniformLifeSpan = glGetUniformLocation(updateProgId, "lifeSpan");
+    uniformFloor    = glGetUniformLocation(updateProgId, "floorHeight");
+    uniformViewMatrix       = glGetUniformLocation(drawProgId, "viewMatrix");
+    uniformProjectionMatrix = glGetUniformLocation(drawProgId, "projectionMatrix");
+    uniformPointScale   = glGetUniformLocation(drawProgId, "pointScale");
+    uniformDrawLifeSpan = glGetUniformLocation(drawProgId, "lifeSpan");
+
+    std::vector<float> data(count * 8, 0.0f);
+    for(int i = 0; i < count; ++i)
+    {
+        float* p = &data[i * 8];
+        p[0] = emitter[0];
+        p[1] = emitter[1];
+        p[2] = emitter[2];
+        p[3] = -lifeSpan * i / count;               // negative life: emit after this delay
+        p[7] = (float)rand() / RAND_MAX * 1000.0f;  // seed
+    }
+
+    vboIds[0] = createVBO(&data[0], count * PARTICLE_STRIDE, GL_ARRAY_BUFFER, GL_DYNAMIC_COPY, "ParticleSystem");
+    vboIds[1] = createVBO(0, count * PARTICLE_STRIDE, GL_ARRAY_BUFFER, GL_DYNAMIC_COPY, "ParticleSystem");
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if(!vboIds[0] || !vboIds[1])
+    {
+        release();
+        return false;
+    }
+
+    this->count = count;
+    current = 0;
+    time = 0;
+    cameraVersion = 0;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete buffers and programs
+///////////////////////////////////////////////////////////////////////////////
+void ParticleSystem::release()
+{
+    deleteVBO(vboIds[0]);
+    deleteVBO(vboIds[1]);
+    vboIds[0] = vboIds[1] = 0;
+    deleteShaderProgram(updateProgId);
+    deleteShaderProgram(drawProgId);
+    updateProgId = drawProgId = 0;
+    count = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the position where particles are respawned
+///////////////////////////////////////////////////////////////////////////////
+void ParticleSystem::setEmitter(float x, float y, float z)
+{
+    emitter[0] = x;
+    emitter[1] = y;
+    emitter[2] = z;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// advance particles by one step: read current buffer as points and capture
+// the integrated state into the other buffer, then swap them
+///////////////////////////////////////////////////////////////////////////////
+void ParticleSystem::update(float dt)
+{
+    if(!count)
+        return;
+
+    time += dt;
+
+    glUseProgram(updateProgId);
+    glUniform1f(uniformDt, dt);
+    glUniform1f(uniformTime, time);
+    glUniform3fv(uniformEmitter, 1, emitter);
+    glUniform1f(uniformLifeSpan, lifeSpan);
+    glUniform1f(uniformFloor, floorHeight);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vboIds[current]);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(4, GL_FLOAT, PARTICLE_STRIDE, 0);
+    glEnableVertexAttribArray(velocityAttrib);
+    glVertexAttribPointer(velocityAttrib, 4, GL_FLOAT, GL_FALSE, PARTICLE_STRIDE, (void*)(4 * sizeof(float)));
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, vboIds[1 - current]);
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, count);
+    glEndTransformFeedback();
+    glDisable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+
+    glDisableVertexAttribArray(velocityAttrib);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+
+    current = 1 - current;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw particles as additive point sprites without writing depth
+// The camera matrices are sent only if the camera changed since last draw.
+///////////////////////////////////////////////////////////////////////////////
+void ParticleSystem::draw(const Camera& camera, float pointScale)
+{
+    if(!count)
+        return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_POINT_SPRITE);
+    glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+
+    glUseProgram(drawProgId);
+    if(cameraVersion != camera.getVersion())
+    {
+        glUniformMatrix4fv(uniformViewMatrix, 1, GL_FALSE, camera.getViewMatrix().get());
+        glUniformMatrix4fv(uniformProjectionMatrix, 1, GL_FALSE, camera.getProjectionMatrix().get());
+        cameraVersion = camera.getVersion();
+    }
+    glUniform1f(uniformPointScale, pointScale);
+    glUniform1f(uniformDrawLifeSpan, lifeSpan);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vboIds[current]);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(4, GL_FLOAT, PARTICLE_STRIDE, 0);
+    glDrawArrays(GL_POINTS, 0, count);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(0);
+    glPopAttrib();
+}
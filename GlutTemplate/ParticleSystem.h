@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// ParticleSystem.h
+// ================
+// GPU particle fountain advanced with transform feedback
+//
+// The particle state lives only in two buffer objects. Each update draws the
+// particles of one buffer as points through a vertex shader that integrates
+// them, and captures the outputs into the other buffer with transform
+// feedback (rasterization discarded). Then the roles of the buffers are
+// swapped (ping-pong). Nothing is uploaded from CPU after init().
+// A particle is drawn as a point sprite attenuated by the distance to camera,
+// using the view and projection matrices of Camera.
+//
+// Each record is 2 vec4s: position with remaining life in w, and velocity
+// with a random seed in w. Expired particles are respawned at the emitter.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "glExtension.h"
+#include "Camera.h"
+
+class ParticleSystem
+{
+public:
+    ParticleSystem();
+    ~ParticleSystem();
+
+    bool init(int count);                           // create buffers and shaders, must be called after RC is open
+    void release();                                 // delete buffers and shaders
+
+    void update(float dt);                          // advance all particles by dt seconds on GPU
+    void draw(const Camera& camera, float pointScale);  // pointScale: sprite size in pixels at unit distance
+
+    void setEmitter(float x, float y, float z);
+    void setLifeSpan(float seconds)                 { lifeSpan = seconds; }
+    void setFloor(float y)                          { floorHeight = y; }
+
+    int getCount() const                            { return count; }
+    bool isInitialized() const                      { return updateProgId != 0; }
+
+private:
+    ParticleSystem(const ParticleSystem& rhs);      // no implementation
+
+    GLuint vboIds[2];                               // ping-pong state buffers
+    int current;                                    // index of buffer holding the latest state
+    int count;
+    float time;
+    float lifeSpan;
+    float floorHeight;
+    float emitter[3];
+
+    GLuint updateProgId;
+    GLint  velocityAttrib;
+    GLint  uniformDt;
+    GLint  uniformTime;
+    GLint  uniformEmitter;
+    GLint  uniformLifeSpan;
+    GLint  uniformFloor;
+
+    GLuint drawProgId;
+    GLint  uniformViewMatrix;
+    GLint  uniformProjectionMatrix;
+    GLint  uniformPointScale;
+    GLint  uniformDrawLifeSpan;
+    unsigned int cameraVersion;                     // camera version of the uploaded matrices
+};
+
+#endif
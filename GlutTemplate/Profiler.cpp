@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// Profiler.cpp
+// ============
+// scoped CPU profiler writing Chrome trace-event JSON
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include "Profiler.h"
+
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        long long start;
+        long long end;
+    };
+
+    // slot of the ring; atomic, since save() may read it while it is written
+    struct EventSlot
+    {
+        std::atomic<const char*> name;
+        std::atomic<long long> start;
+        std::atomic<long long> end;
+    };
+
+    // ring buffer of one thread; only the owner writes events and head
+    struct ThreadBuffer
+    {
+        ThreadBuffer(int id) : events(Profiler::EVENT_CAPACITY), head(0), id(id) {}
+
+        std::vector<EventSlot> events;
+        std::atomic<unsigned long long> head;       // events written so far
+        int id;
+        std::string name;
+    };
+
+    // buffers are never freed, so events of finished threads can be saved
+    std::mutex bufferLock;                          // for registering threads and saving only
+    std::vector<ThreadBuffer*> buffers;
+    thread_local ThreadBuffer* threadBuffer = 0;
+
+    std::atomic<bool> enabled(true);
+    std::vector<long long> frameStarts(Profiler::FRAME_CAPACITY);
+    std::atomic<unsigned long long> frameCount(0);  // frames marked so far
+
+    ThreadBuffer* getThreadBuffer()
+    {
+        if(!threadBuffer)
+        {
+            std::lock_guard<std::mutex> lock(bufferLock);
+            threadBuffer = new ThreadBuffer((int)buffers.size() + 1);
+            buffers.push_back(threadBuffer);
+        }
+        return threadBuffer;
+    }
+
+    // JSON string without quotes; names are identifiers, but be safe
+    std::string escape(const std::string& str)
+    {
+        std::string result;
+        for(size_t i = 0; i < str.size(); ++i)
+        {
+            if(str[i] == '"' || str[i] == '\\')
+                result += '\\';
+            if((unsigned char)str[i] >= 0x20)
+                result += str[i];
+        }
+        return result;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return steady clock time in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+long long Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append an event to the ring buffer of calling thread
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::record(const char* name, long long startNs, long long endNs)
+{
+    if(!enabled.load(std::memory_order_relaxed))
+        return;
+
+    ThreadBuffer* buffer = getThreadBuffer();
+    unsigned long long head = buffer->head.load(std::memory_order_relaxed);
+    EventSlot& e = buffer->events[head % EVENT_CAPACITY];
+
+    // the fence orders the stores after the head published by the last event,
+    // so save() sees that head if it reads any of them
+    std::atomic_thread_fence(std::memory_order_release);
+    e.name.store(name, std::memory_order_relaxed);
+    e.start.store(startNs, std::memory_order_relaxed);
+    e.end.store(endNs, std::memory_order_relaxed);
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remember the start of a frame, called from the render thread only
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::markFrame()
+{
+    unsigned long long count = frameCount.load(std::memory_order_relaxed);
+    frameStarts[count % FRAME_CAPACITY] = now();
+    frameCount.store(count + 1, std::memory_order_release);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// name the calling thread in the trace
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::setThreadName(const char* name)
+{
+    ThreadBuffer* buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(bufferLock);
+    buffer->name = name;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// turn recording on/off
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool flag)
+{
+    enabled.store(flag);
+}
+
+bool Profiler::isEnabled()
+{
+    return enabled.load();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the events since the start of the frames-th last frame as complete
+// ("X") events, with timestamps in microseconds from that frame start
+// If frames is 0, the events since the oldest frame start kept are written,
+// and if no frame is marked, all events in the buffers.
+///////////////////////////////////////////////////////////////////////////////
+bool Profiler::save(const std::string& fileName, int frames)
+{
+    // start time of the oldest requested frame still known
+    unsigned long long marked = frameCount.load(std::memory_order_acquire);
+    unsigned long long back = std::min<unsigned long long>(marked, FRAME_CAPACITY);
+    if(frames > 0)
+        back = std::min<unsigned long long>(back, (unsigned long long)frames);
+    long long since = back > 0 ? frameStarts[(marked - back) % FRAME_CAPACITY] : 0;
+
+    std::ofstream file(fileName.c_str());
+    if(!file)
+    {
+        std::cout << "[Profiler::save()] Failed to open " << fileName << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(bufferLock);
+
+    long long origin = since;                       // trace starts at 0
+    std::vector<Event> copy;
+    int eventCount = 0;
+    char line[512];
+
+    file << "{\"traceEvents\":[\n";
+    snprintf(line, sizeof(line), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"vboCube\"}}");
+    file << line;
+
+    for(size_t b = 0; b < buffers.size(); ++b)
+    {
+        ThreadBuffer* buffer = buffers[b];
+        std::string name = buffer->name.empty() ? "thread " + std::to_string(buffer->id) : buffer->name;
+        snprintf(line, sizeof(line), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                 buffer->id, escape(name).c_str());
+        file << line;
+
+        // copy the valid part of the ring, then keep only the events the
+        // owner cannot have overwritten while copying; the owner may be
+        // writing event headAfter already, which takes the slot of event
+        // headAfter - EVENT_CAPACITY, so that one is dropped too
+        unsigned long long head = buffer->head.load(std::memory_order_acquire);
+        unsigned long long first = head > (unsigned long long)EVENT_CAPACITY ? head - EVENT_CAPACITY : 0;
+        copy.clear();
+        for(unsigned long long i = first; i < head; ++i)
+        {
+            const EventSlot& slot = buffer->events[i % EVENT_CAPACITY];
+            Event e = { slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                        slot.end.load(std::memory_order_relaxed) };
+            copy.push_back(e);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);   // pairs with the fence in record()
+        unsigned long long headAfter = buffer->head.load(std::memory_order_relaxed);
+        unsigned long long safe = headAfter + 1 > (unsigned long long)EVENT_CAPACITY ? headAfter + 1 - EVENT_CAPACITY : 0;
+        size_t skip = safe > first ? (size_t)std::min<unsigned long long>(safe - first, copy.size()) : 0;
+
+        for(size_t i = skip; i < copy.size(); ++i)
+        {
+            const Event& e = copy[i];
+            if(e.end < since)
+                continue;
+            snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                     escape(e.name).c_str(), buffer->id, (e.start - origin) * 1e-3, (e.end - e.start) * 1e-3);
+            file << line;
+            ++eventCount;
+        }
+    }
+
+    // frame starts as global instant events
+    for(unsigned long long i = marked - back; i < marked; ++i)
+    {
+        long long t = frameStarts[i % FRAME_CAPACITY];
+        snprintf(line, sizeof(line), ",\n{\"name\":\"frame %llu\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}",
+                 i, (t - origin) * 1e-3);
+        file << line;
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    std::cout << "Saved " << eventCount << " profiler events of " << back << " frames to " << fileName << std::endl;
+    return (bool)file;
+}
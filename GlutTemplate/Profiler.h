@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// Profiler.h
+// ==========
+// scoped CPU profiler writing Chrome trace-event JSON
+//
+// PROFILE_SCOPE("name") records the time from the marker to the end of the
+// enclosing scope; PROFILE_FUNCTION() uses the function name. The name must
+// be a string literal or otherwise outlive the profiler, since only the
+// pointer is stored.
+// Each thread writes its events to its own ring buffer, created on the first
+// event of the thread. Only the owner thread writes, so recording takes no
+// lock: two clock reads, three relaxed atomic stores (plain stores on x86)
+// and a release store of the head index.
+// save() may run on any thread; it copies the events, then drops the ones
+// the owner may have overwritten or be writing during the copy, the same way
+// a seqlock reader detects a torn read.
+// markFrame() stores the start time of a frame, so save() can write the
+// events of the last N frames. Open the file in chrome://tracing or
+// https://ui.perfetto.dev.
+// Define NO_PROFILER to compile the markers out.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <string>
+
+class Profiler
+{
+public:
+    static const int EVENT_CAPACITY = 64 * 1024;    // events kept per thread
+    static const int FRAME_CAPACITY = 1024;         // frame starts kept
+
+    static long long now();                         // monotonic clock in nanoseconds
+    static void record(const char* name, long long startNs, long long endNs);
+    static void markFrame();                        // call at start of each frame
+    static void setThreadName(const char* name);    // shown in trace, call on the thread
+    static void setEnabled(bool flag);
+    static bool isEnabled();
+
+    // write events of the last frameCount frames from all threads
+    static bool save(const std::string& fileName, int frameCount);
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+// records its lifetime as an event
+///////////////////////////////////////////////////////////////////////////////
+class ProfileScope
+{
+public:
+    ProfileScope(const char* name) : name(name), start(Profiler::now()) {}
+    ~ProfileScope()                                 { Profiler::record(name, start, Profiler::now()); }
+
+private:
+    ProfileScope(const ProfileScope& rhs);          // no implementation
+    const char* name;
+    long long start;
+};
+
+
+#ifdef NO_PROFILER
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#else
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#endif
+
+#endif
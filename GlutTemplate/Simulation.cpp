@@ -0,0 +1,409 @@
+///////////////////////////////////////////////////////////////////////////////
+// Simulation.cpp
+// ==============
+// object simulation running on its own thread, or stepped by the render
+// thread in manual mode
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include "Simulation.h"
+#include "VectorMath.h"
+#include "Profiler.h"
+
+// constants
+const double SIM_STEP        = 1.0 / 120.0; // seconds per simulation step
+const int    MAX_PENDING_OPS = 4096;        // beyond this, render thread replaces everything
+const float  BOUNCE_HEIGHT   = 0.5f;        // amplitude of moving objects
+const float  SPIN_SPEED      = 1.5f;        // radian per second of moving objects
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+Simulation::Simulation() : stepDirty(0), stepFull(true), pendingDirty(0), pendingFull(false),
+                           gridExtent(0), objectScale(1), time(0), manual(false),
+                           manualClock(SIM_STEP), running(false),
+                           addRequests(0), removeRequests(0), movingCount(400), animated(true),
+                           collision(true), pairCount(0), broadphaseTime(0), broadphaseAxis(0),
+                           objectCount(0), stepCount(0)
+{
+    for(int i = 0; i < 3; ++i)
+    {
+        boundsMin[i] = -0.5f;
+        boundsMax[i] = 0.5f;
+    }
+}
+Simulation::~Simulation()
+{
+    stop();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// place objects on a grid in XZ plane and start simulation thread
+// With count, the grid is filled row by row until count objects are placed.
+// In manual mode, no thread is started and advance() runs the steps.
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::start(int gridSize, float spacing, float scale, int count)
+{
+    stop();
+
+    const float half = (gridSize - 1) * spacing * 0.5f;
+    gridExtent = (gridSize - 1) * spacing;
+    objectScale = scale;
+
+    instances.clear();
+    if(count < 0 || count > gridSize * gridSize)
+        count = gridSize * gridSize;
+    instances.reserve(count);
+    baseHeights.assign(count, 0.0f);
+    for(int i = 0; i < gridSize; ++i)
+    {
+        for(int j = 0; j < gridSize && (int)instances.size() < count; ++j)
+        {
+            Instance inst = { j * spacing - half, 0, i * spacing - half, scale, 0, 0, 0, 1 };
+            instances.push_back(inst);
+        }
+    }
+    objectCount = (int)instances.size();
+
+    // the first snapshot replaces everything on render side
+    stepOps.clear();
+    stepDirty.clear();
+    stepFull = true;
+    time = 0;
+
+    if(manual)
+    {
+        manualClock.setManual(true);
+        manualClock.reset();
+        return;
+    }
+    running = true;
+    thread = std::thread(&Simulation::run, this);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set local bounding box of object mesh, must be called before start()
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::setObjectBounds(const float min[3], const float max[3])
+{
+    for(int i = 0; i < 3; ++i)
+    {
+        boundsMin[i] = min[i];
+        boundsMax[i] = max[i];
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// stop and join simulation thread and broadphase workers
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::stop()
+{
+    if(thread.joinable())
+    {
+        running = false;
+        thread.join();
+    }
+    broadphase.stopWorkers();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// thread loop, run the steps due and publish once, then sleep until next step
+// StepClock limits the catch-up steps, so a stalled simulation slows down
+// instead of bursting.
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::run()
+{
+    Profiler::setThreadName("simulation");
+    StepClock clock(SIM_STEP);
+    while(running)
+    {
+        int steps = clock.advance();
+        for(int i = 0; i < steps; ++i)
+            step();
+        if(steps > 0)
+            publish();
+
+        double remaining = (1.0 - clock.getAlpha()) * SIM_STEP;
+        std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// manual mode: run the steps due after the given time on the calling thread
+// and publish once, the same as a loop of run() would
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::advance(double seconds)
+{
+    if(!manual || thread.joinable())
+        return;
+
+    manualClock.addTime(seconds);
+    int steps = manualClock.advance();
+    for(int i = 0; i < steps; ++i)
+        step();
+    if(steps > 0)
+        publish();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// advance one fixed step
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::step()
+{
+    PROFILE_FUNCTION();
+    applyRequests();
+    updateObjects();
+    collideObjects();
+    ++stepCount;
+    time = stepCount * SIM_STEP;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add/remove objects requested by other threads
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::applyRequests()
+{
+    int adds = addRequests.exchange(0);
+    int removes = removeRequests.exchange(0);
+
+    if(adds > 0)
+    {
+        // new objects at random positions above the grid
+        int first = (int)instances.size();
+        for(int i = 0; i < adds; ++i)
+        {
+            Instance inst;
+            inst.x = (rand() / (float)RAND_MAX - 0.5f) * gridExtent;
+            inst.y = (rand() / (float)RAND_MAX) * 2.0f + 0.5f;
+            inst.z = (rand() / (float)RAND_MAX - 0.5f) * gridExtent;
+            inst.scale = objectScale;
+            inst.qx = inst.qy = inst.qz = 0;
+            inst.qw = 1;
+            instances.push_back(inst);
+            baseHeights.push_back(inst.y);
+        }
+        InstanceOp op = { InstanceOp::ADD, adds, stepCount + 1 };
+        stepOps.push_back(op);
+        stepDirty.add(first, adds);
+    }
+
+    for(int i = 0; i < removes && !instances.empty(); ++i)
+    {
+        // swap-and-pop, same as InstanceBuffer::remove() on render side
+        int index = rand() % (int)instances.size();
+        int last = (int)instances.size() - 1;
+
+        // the moved record is copied on GPU side; if it has not been uploaded
+        // yet, the copy is stale, so upload its new slot as well
+        if(index != last && (stepDirty.contains(last) || pendingDirty.contains(last)))
+            stepDirty.add(index);
+
+        instances[index] = instances.back();
+        instances.pop_back();
+        baseHeights[index] = baseHeights.back();
+        baseHeights.pop_back();
+
+        InstanceOp op = { InstanceOp::REMOVE, index, stepCount + 1 };
+        stepOps.push_back(op);
+    }
+
+    objectCount = (int)instances.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// bounce a subset of objects and mark the modified records dirty
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::updateObjects()
+{
+    int count = (int)instances.size();
+    int moving = movingCount;
+    if(!animated || moving <= 0 || count == 0)
+        return;
+
+    int step = count / moving;
+    if(step < 1)
+        step = 1;
+
+    // spin about a tilted vertical axis by one step; compose() has no state
+    // and keeps the orientations unit length however long they spin
+    const Quat spin = Quat::fromAxisAngle(Vec3(0.3f, 1.0f, 0.0f), SPIN_SPEED * (float)SIM_STEP);
+
+    float t = (float)time;
+    for(int i = 0, moved = 0; i < count && moved < moving; i += step, ++moved)
+    {
+        Instance& inst = instances[i];
+        inst.y = baseHeights[i] + BOUNCE_HEIGHT * sinf(t * 2.0f + i * 0.01f);
+        Quat q = compose(spin, Quat(inst.qx, inst.qy, inst.qz, inst.qw));
+        inst.qx = q.x;
+        inst.qy = q.y;
+        inst.qz = q.z;
+        inst.qw = q.w;
+        stepDirty.add(i);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find overlapping objects and push each pair apart along the axis of least
+// penetration, half each; vertical correction moves the resting height so
+// the bounce animation keeps it
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::collideObjects()
+{
+    PROFILE_FUNCTION();
+    int count = (int)instances.size();
+    if(!collision || count < 2)
+    {
+        pairCount = 0;
+        return;
+    }
+
+    for(int a = 0; a < 3; ++a)
+    {
+        boxMin[a].resize(count);
+        boxMax[a].resize(count);
+    }
+    // world AABB of the rotated local box: center is rotated, half extents
+    // are projected with the absolute rotation matrix
+    Vec3 localCenter((boundsMin[0] + boundsMax[0]) * 0.5f, (boundsMin[1] + boundsMax[1]) * 0.5f,
+                     (boundsMin[2] + boundsMax[2]) * 0.5f);
+    Vec3 localHalf((boundsMax[0] - boundsMin[0]) * 0.5f, (boundsMax[1] - boundsMin[1]) * 0.5f,
+                   (boundsMax[2] - boundsMin[2]) * 0.5f);
+    for(int i = 0; i < count; ++i)
+    {
+        const Instance& inst = instances[i];
+        Quat q(inst.qx, inst.qy, inst.qz, inst.qw);
+        Vec3 center = Vec3(inst.x, inst.y, inst.z) + rotate(q, localCenter) * inst.scale;
+        Vec3 half = localHalf * inst.scale;
+        if(inst.qw < 1.0f)
+        {
+            Mat4 r = Mat4::rotation(q);
+            half.set(fabsf(r.at(0, 0)) * half.x + fabsf(r.at(0, 1)) * half.y + fabsf(r.at(0, 2)) * half.z,
+                     fabsf(r.at(1, 0)) * half.x + fabsf(r.at(1, 1)) * half.y + fabsf(r.at(1, 2)) * half.z,
+                     fabsf(r.at(2, 0)) * half.x + fabsf(r.at(2, 1)) * half.y + fabsf(r.at(2, 2)) * half.z);
+        }
+        boxMin[0][i] = center.x - half.x;
+        boxMin[1][i] = center.y - half.y;
+        boxMin[2][i] = center.z - half.z;
+        boxMax[0][i] = center.x + half.x;
+        boxMax[1][i] = center.y + half.y;
+        boxMax[2][i] = center.z + half.z;
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    const std::vector<Broadphase::Pair>& pairs = broadphase.findPairs(&boxMin[0][0], &boxMin[1][0], &boxMin[2][0],
+                                                                      &boxMax[0][0], &boxMax[1][0], &boxMax[2][0], count);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    broadphaseTime = std::chrono::duration<float, std::milli>(t1 - t0).count();
+    broadphaseAxis = broadphase.getAxis();
+    pairCount = (int)pairs.size();
+
+    for(size_t i = 0; i < pairs.size(); ++i)
+    {
+        int a = pairs[i].a;
+        int b = pairs[i].b;
+
+        // penetration depth and direction (from a to b) on each axis
+        int axis = 0;
+        float depth = std::numeric_limits<float>::max();
+        float sign = 1;
+        for(int k = 0; k < 3; ++k)
+        {
+            float d1 = boxMax[k][a] - boxMin[k][b];     // b is on positive side of a
+            float d2 = boxMax[k][b] - boxMin[k][a];     // b is on negative side of a
+            float d = d1 < d2 ? d1 : d2;
+            if(d < depth)
+            {
+                depth = d;
+                axis = k;
+                sign = d1 < d2 ? 1.0f : -1.0f;
+            }
+        }
+
+        float push = depth * 0.5f * sign;
+        float* pa = &instances[a].x;
+        float* pb = &instances[b].x;
+        pa[axis] -= push;
+        pb[axis] += push;
+        if(axis == 1)
+        {
+            baseHeights[a] -= push;
+            baseHeights[b] += push;
+        }
+        stepDirty.add(a);
+        stepDirty.add(b);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the state into the back slot and publish it
+// The snapshot carries all changes since the last snapshot known to be taken.
+// If the previous snapshot has been taken, the render thread has seen
+// everything except this step; otherwise the previous snapshot is dropped and
+// its changes are carried over to the next one. The render thread may still
+// take this snapshot before the next one is published, so the next one can
+// repeat this step; InstanceOp::step lets the render thread skip it.
+///////////////////////////////////////////////////////////////////////////////
+void Simulation::publish()
+{
+    PROFILE_FUNCTION();
+    if(stepOps.empty() && stepDirty.empty() && !stepFull)
+        return;                                     // nothing to draw, leave the last snapshot as it is
+
+    pendingOps.insert(pendingOps.end(), stepOps.begin(), stepOps.end());
+    const std::vector<DirtyRanges::Range>& ranges = stepDirty.getRanges();
+    for(size_t i = 0; i < ranges.size(); ++i)
+        pendingDirty.add(ranges[i].first, ranges[i].count);
+    pendingFull = pendingFull || stepFull || (int)pendingOps.size() > MAX_PENDING_OPS;
+    if(pendingFull)
+    {
+        pendingOps.clear();
+        pendingDirty.clear();
+    }
+
+    SimSnapshot& snapshot = snapshots.getBack();
+    snapshot.instances = instances;
+    snapshot.ops = pendingOps;
+    snapshot.dirty = pendingDirty;
+    snapshot.full = pendingFull;
+    snapshot.step = stepCount;
+    snapshot.time = time;
+
+    if(snapshots.publish())
+    {
+        pendingOps = stepOps;
+        pendingDirty = stepDirty;
+        pendingFull = stepFull;
+    }
+
+    stepOps.clear();
+    stepDirty.clear();
+    stepFull = false;
+}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// Simulation.h
+// ============
+// object simulation running on its own thread
+//
+// The simulation thread owns the object state, advances it in fixed steps
+// driven by a StepClock, and publishes a snapshot through a TripleBuffer, so
+// the render thread never waits for the simulation and the simulation never
+// waits for vsync. The state depends only on the step count.
+// Overlapping objects are found with a sort-and-sweep Broadphase every step
+// and pushed apart along the axis of least penetration.
+// Since the render thread may skip snapshots, each snapshot carries all the
+// changes since the last snapshot the render thread is known to have taken:
+// the structural changes (added/removed objects) in order, and the dirty
+// record ranges. It can be more than needed because the render thread may
+// take a snapshot while the next one is being built, so every structural
+// change is tagged with its step and the render thread replays only the ones
+// newer than the snapshot it has drawn. Dirty ranges are uploaded from the
+// latest state, so extra ranges only cost bandwidth.
+// Steps changing nothing publish nothing, so an unread snapshot means that
+// the scene has changed since the render thread took the last one.
+// In manual mode (headless and --play runs), start() does not create the
+// thread; the render thread calls advance() with the time of each frame and
+// the steps run on its own thread, so every frame draws the same state on
+// any machine.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "DirtyRanges.h"
+#include "TripleBuffer.h"
+#include "Broadphase.h"
+#include "StepClock.h"
+
+// per-object state, converted to an instance matrix when uploaded
+struct Instance
+{
+    float x, y, z;                                  // position
+    float scale;
+    float qx, qy, qz, qw;                           // orientation (unit quaternion)
+};
+
+// structural change of the object array
+struct InstanceOp
+{
+    enum Type { ADD, REMOVE };
+    Type type;
+    int value;                                      // ADD: number of records, REMOVE: index (swap-and-pop)
+    unsigned long step;                             // simulation step of the change
+};
+
+// object state published by the simulation thread
+struct SimSnapshot
+{
+    std::vector<Instance> instances;                // all objects
+    std::vector<InstanceOp> ops;                    // structural changes, may include already taken steps
+    DirtyRanges dirty;                              // modified records since last taken snapshot
+    bool full;                                      // changes are not tracked, replace everything
+    unsigned long step;                             // simulation step number
+    double time;                                    // simulation time in seconds
+
+    SimSnapshot() : dirty(0), full(true), step(0), time(0) {}
+};
+
+class Simulation
+{
+public:
+    Simulation();
+    ~Simulation();
+
+    void start(int gridSize, float spacing, float scale, int count=-1);   // create grid of objects (first count only) and start thread
+    void stop();
+    void setManual(bool flag)                       { manual = flag; }  // call before start()
+    bool isManual() const                           { return manual; }
+    void advance(double seconds);                   // manual mode: run the steps due and publish
+    void setObjectBounds(const float min[3], const float max[3]);  // local AABB of object mesh
+
+    // render thread: take the latest snapshot if new one is available
+    bool acquire()                                  { return snapshots.update(); }
+    const SimSnapshot& getSnapshot() const          { return snapshots.getFront(); }
+    bool hasNewSnapshot() const                     { return snapshots.hasFresh(); }    // acquire() would take one
+
+    // requests from any thread, applied at the next step
+    void addObjects(int count)                      { addRequests += count; }
+    void removeObjects(int count)                   { removeRequests += count; }
+    void setMovingCount(int count)                  { movingCount = count < 0 ? 0 : count; }
+    int  getMovingCount() const                     { return movingCount; }
+    void setAnimated(bool flag)                     { animated = flag; }
+    bool isAnimated() const                         { return animated; }
+    void setCollision(bool flag)                    { collision = flag; }
+    bool isCollision() const                        { return collision; }
+    int  getPairCount() const                       { return pairCount; }
+    float getBroadphaseTime() const                 { return broadphaseTime; }  // ms
+    int  getBroadphaseAxis() const                  { return broadphaseAxis; }
+    int  getBroadphaseThreads() const               { return broadphase.getThreadCount(); }
+    int  getObjectCount() const                     { return objectCount; }
+    unsigned long getStepCount() const              { return stepCount; }
+
+private:
+    Simulation(const Simulation& rhs);              // no implementation
+    void run();
+    void step();                                    // advance one fixed step
+    void applyRequests();
+    void updateObjects();
+    void collideObjects();
+    void publish();
+
+    // state owned by simulation thread
+    std::vector<Instance> instances;
+    std::vector<float> baseHeights;                 // resting height of each object
+    std::vector<InstanceOp> stepOps;                // changes in the current step
+    DirtyRanges stepDirty;
+    bool stepFull;
+    std::vector<InstanceOp> pendingOps;             // changes not yet taken by render thread
+    DirtyRanges pendingDirty;
+    bool pendingFull;
+    float gridExtent;                               // size of the area where objects are added
+    float objectScale;
+    float boundsMin[3];                             // local AABB of object mesh
+    float boundsMax[3];
+    std::vector<float> boxMin[3];                   // world AABBs as SoA for broadphase
+    std::vector<float> boxMax[3];
+    Broadphase broadphase;
+    double time;
+    bool manual;                                    // stepped by advance() instead of thread
+    StepClock manualClock;                          // fed by advance()
+
+    TripleBuffer<SimSnapshot> snapshots;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<int> addRequests;
+    std::atomic<int> removeRequests;
+    std::atomic<int> movingCount;                   // number of animated objects, spread evenly
+    std::atomic<bool> animated;
+    std::atomic<bool> collision;
+    std::atomic<int> pairCount;
+    std::atomic<float> broadphaseTime;
+    std::atomic<int> broadphaseAxis;
+    std::atomic<int> objectCount;
+    std::atomic<unsigned long> stepCount;
+};
+
+#endif
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// StepClock.cpp
+// =============
+// fixed-timestep clock with accumulator and interpolation factor
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StepClock.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+StepClock::StepClock(double stepSeconds, int maxSteps) : step(stepSeconds), maxSteps(maxSteps),
+                                                         accumulator(0), stepCount(0), manual(false)
+{
+    reset();
+}
+StepClock::~StepClock()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// restart from step 0
+///////////////////////////////////////////////////////////////////////////////
+void StepClock::reset()
+{
+    accumulator = 0;
+    stepCount = 0;
+    lastTime = Clock::now();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add elapsed time since last call and consume it in whole steps
+// It returns the number of steps the caller must run. If the caller is too
+// slow to keep up, the steps are limited to maxSteps and the excess time is
+// dropped, so a long stall does not cause a burst of catch-up steps.
+///////////////////////////////////////////////////////////////////////////////
+int StepClock::advance()
+{
+    if(!manual)
+    {
+        Clock::time_point now = Clock::now();
+        accumulator += std::chrono::duration<double>(now - lastTime).count();
+        lastTime = now;
+    }
+
+    int steps = 0;
+    while(accumulator >= step && steps < maxSteps)
+    {
+        accumulator -= step;
+        ++steps;
+    }
+    if(steps == maxSteps && accumulator >= step)
+        accumulator = 0;
+
+    stepCount += steps;
+    return steps;
+}
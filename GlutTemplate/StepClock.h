@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+// StepClock.h
+// ===========
+// fixed-timestep clock with accumulator and interpolation factor
+//
+// The real elapsed time (monotonic, high resolution) is accumulated and
+// consumed in whole steps of fixed length, so the result of a simulation
+// depends only on the number of steps, not on the frame rate. The remainder
+// gives the interpolation factor (alpha) between the previous and the current
+// step for rendering.
+// In manual mode, time is not read from the system clock; the caller feeds
+// time with addTime(), which makes runs repeatable at any frame rate.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef STEP_CLOCK_H
+#define STEP_CLOCK_H
+
+#include <chrono>
+
+class StepClock
+{
+public:
+    StepClock(double stepSeconds, int maxSteps=8);
+    ~StepClock();
+
+    void reset();                                   // restart from step 0
+    int  advance();                                 // accumulate elapsed time, return number of steps to run
+    void addTime(double seconds)                    { accumulator += seconds; }
+
+    void setManual(bool flag)                       { manual = flag; lastTime = Clock::now(); }
+    bool isManual() const                           { return manual; }
+
+    double getStep() const                          { return step; }
+    unsigned long getStepCount() const              { return stepCount; }
+    double getTime() const                          { return stepCount * step; }    // simulated time
+    double getAlpha() const                         { return accumulator / step; }  // [0, 1)
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    double step;                                    // seconds per step
+    int maxSteps;                                   // max steps per advance() to avoid spiral of death
+    double accumulator;                             // time not yet consumed by steps
+    unsigned long stepCount;
+    bool manual;
+    Clock::time_point lastTime;
+};
+
+#endif
@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+// TextRenderer.cpp
+// ================
+// 2D text overlay drawn from a glyph atlas texture in one draw call
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdarg>
+#include "TextRenderer.h"
+#include "Font8x13.h"
+#include "vbo.h"
+#include "BufferRegistry.h"
+
+const int MAX_FORMATTED = 512;                      // max length of a string by addTextf()
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+TextRenderer::TextRenderer() : texId(0), vboId(0), vboSize(0), drawnGlyphs(0)
+{
+}
+TextRenderer::~TextRenderer()
+{
+    // the texture and buffer must be released by release() while RC is still open
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pack the font bitmaps into an alpha texture
+// If buffer objects are not supported, the vertices are drawn from client
+// memory instead.
+///////////////////////////////////////////////////////////////////////////////
+bool TextRenderer::init()
+{
+    release();
+
+    std::vector<unsigned char> atlas(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+    const int columns = ATLAS_WIDTH / CELL_SIZE;
+    for(int i = 0; i < FONT_CHAR_COUNT; ++i)
+    {
+        int x0 = (i % columns) * CELL_SIZE;
+        int y0 = (i / columns) * CELL_SIZE;
+        for(int row = 0; row < FONT_HEIGHT; ++row)
+        {
+            unsigned char bits = FONT_8X13[i][row];
+            for(int col = 0; col < FONT_WIDTH; ++col)
+            {
+                if(bits & (0x80 >> col))
+                    atlas[(y0 + row) * ATLAS_WIDTH + x0 + col] = 255;
+            }
+        }
+    }
+
+    // solid cell after the glyphs for filled rectangles
+    int solidX = (FONT_CHAR_COUNT % columns) * CELL_SIZE;
+    int solidY = (FONT_CHAR_COUNT / columns) * CELL_SIZE;
+    for(int row = 0; row < CELL_SIZE; ++row)
+    {
+        for(int col = 0; col < CELL_SIZE; ++col)
+            atlas[(solidY + row) * ATLAS_WIDTH + solidX + col] = 255;
+    }
+
+    glGenTextures(1, &texId);
+    glBindTexture(GL_TEXTURE_2D, texId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_ALPHA, GL_UNSIGNED_BYTE, &atlas[0]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if(glExtension::getInstance().isSupported("GL_ARB_vertex_buffer_object"))
+    {
+        vboSize = 256 * 4 * sizeof(Vertex);
+        vboId = createVBO(0, vboSize, GL_ARRAY_BUFFER, GL_STREAM_DRAW, "TextRenderer");
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if(!vboId)
+            vboSize = 0;
+    }
+
+    vertices.reserve(256 * 4);
+    return texId != 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete texture and buffer
+///////////////////////////////////////////////////////////////////////////////
+void TextRenderer::release()
+{
+    if(texId)
+        glDeleteTextures(1, &texId);
+    texId = 0;
+    deleteVBO(vboId);
+    vboId = 0;
+    vboSize = 0;
+    vertices.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// texture coords of a glyph in the atlas; unknown characters map to '?'
+///////////////////////////////////////////////////////////////////////////////
+void TextRenderer::getGlyphTexCoords(char c, float& s0, float& t0, float& s1, float& t1)
+{
+    int i = (unsigned char)c - FONT_FIRST_CHAR;
+    if(i < 0 || i >= FONT_CHAR_COUNT)
+        i = '?' - FONT_FIRST_CHAR;
+
+    const int columns = ATLAS_WIDTH / CELL_SIZE;
+    int x = (i % columns) * CELL_SIZE;
+    int y = (i / columns) * CELL_SIZE;
+    s0 = (float)x / ATLAS_WIDTH;
+    t0 = (float)y / ATLAS_HEIGHT;
+    s1 = (float)(x + FONT_WIDTH) / ATLAS_WIDTH;
+    t1 = (float)(y + FONT_HEIGHT) / ATLAS_HEIGHT;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove the queued text
+///////////////////////////////////////////////////////////////////////////////
+void TextRenderer::clear()
+{
+    vertices.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// queue a string at the window position, y is the baseline
+///////////////////////////////////////////////////////////////////////////////
+int TextRenderer::addText(int x, int y, const char* str, const float color[4])
+{
+    unsigned char rgba[4];
+    for(int i = 0; i < 4; ++i)
+        rgba[i] = (unsigned char)(color[i] * 255.0f + 0.5f);
+
+    float y0 = (float)(y - FONT_BASELINE);
+    float y1 = y0 + FONT_HEIGHT;
+    for(; *str; ++str, x += FONT_WIDTH)
+    {
+        if(*str == ' ')
+            continue;
+
+        float s0, t0, s1, t1;
+        getGlyphTexCoords(*str, s0, t0, s1, t1);
+        float x0 = (float)x;
+        float x1 = x0 + FONT_WIDTH;
+
+        Vertex v[4] = { { x0, y0, s0, t0, {} }, { x1, y0, s1, t0, {} },
+                        { x1, y1, s1, t1, {} }, { x0, y1, s0, t1, {} } };
+        for(int i = 0; i < 4; ++i)
+        {
+            v[i].color[0] = rgba[0];
+            v[i].color[1] = rgba[1];
+            v[i].color[2] = rgba[2];
+            v[i].color[3] = rgba[3];
+            vertices.push_back(v[i]);
+        }
+    }
+    return x;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// queue a filled rectangle, drawn in the same batch as the text
+// All corners sample the middle of the solid cell in the atlas.
+///////////////////////////////////////////////////////////////////////////////
+void TextRenderer::addRect(float x, float y, float width, float height, const float color[4])
+{
+    const int columns = ATLAS_WIDTH / CELL_SIZE;
+    float s = ((FONT_CHAR_COUNT % columns) * CELL_SIZE + CELL_SIZE * 0.5f) / ATLAS_WIDTH;
+    float t = ((FONT_CHAR_COUNT / columns) * CELL_SIZE + CELL_SIZE * 0.5f) / ATLAS_HEIGHT;
+
+    Vertex v = { x, y, s, t, {} };
+    for(int i = 0; i < 4; ++i)
+        v.color[i] = (unsigned char)(color[i] * 255.0f + 0.5f);
+
+    vertices.push_back(v);
+    v.x = x + width;
+    vertices.push_back(v);
+    v.y = y + height;
+    vertices.push_back(v);
+    v.x = x;
+    vertices.push_back(v);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// queue a printf-style formatted string
+///////////////////////////////////////////////////////////////////////////////
+int TextRenderer::addTextf(int x, int y, const float color[4], const char* format, ...)
+{
+    char buffer[MAX_FORMATTED];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, MAX_FORMATTED, format, args);
+    va_end(args);
+    return addText(x, y, buffer, color);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw all queued text over the scene with one draw call
+// The buffer is re-specified (orphaned) every frame, so the driver does not
+// wait for the previous frame still reading it.
+///////////////////////////////////////////////////////////////////////////////
+void TextRenderer::draw(int screenWidth, int screenHeight)
+{
+    drawnGlyphs = getGlyphCount();
+    if(!texId || vertices.empty())
+    {
+        vertices.clear();
+        return;
+    }
+
+    int dataSize = (int)(vertices.size() * sizeof(Vertex));
+    const char* base = (const char*)&vertices[0];
+    if(vboId)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vboId);
+        while(vboSize < dataSize)
+            vboSize *= 2;
+        glBufferData(GL_ARRAY_BUFFER, vboSize, 0, GL_STREAM_DRAW);
+        BufferRegistry::resize(vboId, vboSize);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, base);
+        base = 0;
+    }
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT | GL_POLYGON_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, texId);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    // window coords
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, screenWidth, 0, screenHeight, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), base);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), base + 2 * sizeof(float));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), base + 4 * sizeof(float));
+    glDrawArrays(GL_QUADS, 0, (GLsizei)vertices.size());
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopClientAttrib();
+    glPopAttrib();
+    if(vboId)
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    vertices.clear();
+}
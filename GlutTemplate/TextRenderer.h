@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////
+// TextRenderer.h
+// ==============
+// 2D text overlay drawn from a glyph atlas texture in one draw call
+//
+// The glyphs of the fixed 8x13 font are packed into an alpha texture once at
+// init(). addText() only appends a textured quad per character to a vertex
+// array in memory; draw() streams the whole array into a buffer object and
+// renders every string of the frame with a single glDrawArrays(), instead of
+// glRasterPos() and glutBitmapCharacter() per glyph.
+// addTextf() formats into a stack buffer, so a frame of HUD text does not
+// allocate once the vertex array has grown to its working size.
+//
+// The coordinates are window pixels with the origin at the bottom-left, and
+// y is the baseline of the text, the same as glRasterPos2i().
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <vector>
+#include "glExtension.h"
+
+class TextRenderer
+{
+public:
+    TextRenderer();
+    ~TextRenderer();
+
+    bool init();                                    // create atlas and buffer, must be called after RC is open
+    void release();
+
+    void clear();                                   // remove all text added since last draw
+    int  addText(int x, int y, const char* str, const float color[4]);  // return x after the last character
+    int  addTextf(int x, int y, const float color[4], const char* format, ...);
+    void addRect(float x, float y, float width, float height, const float color[4]);  // e.g. graph bars
+    void draw(int screenWidth, int screenHeight);   // draw all text, then clear
+
+    int getGlyphCount() const                       { return (int)vertices.size() / 4; }   // including rects
+    int getDrawnGlyphCount() const                  { return drawnGlyphs; }
+    GLuint getTextureId() const                     { return texId; }
+
+    // atlas layout, shared with other renderers using the same texture
+    static const int ATLAS_WIDTH  = 256;
+    static const int ATLAS_HEIGHT = 128;
+    static const int CELL_SIZE    = 16;             // one glyph per 16x16 cell
+    static void getGlyphTexCoords(char c, float& s0, float& t0, float& s1, float& t1);
+
+private:
+    TextRenderer(const TextRenderer& rhs);          // no implementation
+
+    struct Vertex
+    {
+        float x, y;
+        float s, t;
+        unsigned char color[4];
+    };
+
+    std::vector<Vertex> vertices;                   // 4 per glyph
+    GLuint texId;
+    GLuint vboId;
+    int vboSize;                                    // bytes allocated for vboId
+    int drawnGlyphs;                                // glyphs in the last draw()
+};
+
+#endif
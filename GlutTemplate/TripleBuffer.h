@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// TripleBuffer.h
+// ==============
+// lock-free single-producer/single-consumer triple buffer
+//
+// The producer always owns the back slot and the consumer the front slot. The
+// third (middle) slot holds the latest complete value and is exchanged with
+// an atomic, so neither side ever waits for the other. A value published
+// while the previous one is still unread replaces it; the consumer always gets
+// the latest one.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : middle(1), back(0), front(2)   {}
+
+    // producer side
+    T& getBack()                                    { return slots[back]; }
+
+    // make back slot the latest value and take the middle one as new back slot
+    // It returns true if the previous value had been taken by the consumer.
+    bool publish()
+    {
+        int prev = middle.exchange(back | FRESH_BIT, std::memory_order_acq_rel);
+        back = prev & INDEX_MASK;
+        return (prev & FRESH_BIT) == 0;
+    }
+
+    // consumer side
+    const T& getFront() const                       { return slots[front]; }
+
+    // true if a value was published since the last update(), without taking it
+    bool hasFresh() const                           { return (middle.load(std::memory_order_relaxed) & FRESH_BIT) != 0; }
+
+    // take the latest value if there is a new one since the last call
+    bool update()
+    {
+        if((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+            return false;
+
+        int prev = middle.exchange(front, std::memory_order_acq_rel);
+        front = prev & INDEX_MASK;
+        return true;
+    }
+
+private:
+    TripleBuffer(const TripleBuffer& rhs);          // no implementation
+
+    static const int INDEX_MASK = 3;
+    static const int FRESH_BIT = 4;                 // set when middle slot has not been read
+
+    T slots[3];
+    std::atomic<int> middle;                        // index of middle slot with FRESH_BIT
+    int back;                                       // used by producer only
+    int front;                                      // used by consumer only
+};
+
+#endif
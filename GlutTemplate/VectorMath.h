@@ -0,0 +1,741 @@
+///////////////////////////////////////////////////////////////////////////////
+// VectorMath.h
+// ============
+// header-only 3D math: Vec3, Vec4, Quat and Mat4 value types, and batch
+// functions over SoA arrays vectorized with SSE, AVX or NEON
+//
+// The value types are plain structs of floats for single elements, e.g. the
+// trackball. The batch functions take each component in a separate array
+// (Vec3SoA) and process simd::WIDTH elements per iteration; the remaining
+// elements are done one by one. The SIMD path is selected at compile time:
+// AVX when compiled with -mavx (/arch:AVX), SSE on x86-64 (always available),
+// NEON on ARM, otherwise scalar code. Define VECTORMATH_SCALAR to force the
+// scalar code, e.g. to compare against the SIMD path (see MicroBench.h).
+//
+// batchQuatToMatrix() converts orientations, positions and scales of objects
+// into 3x4 instance matrices, writing them directly to a mapped buffer.
+//
+// Mat4 is column-major like OpenGL, m[column*4 + row].
+// Quat is (x, y, z, w) with w as the scalar part.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECTOR_MATH_H
+#define VECTOR_MATH_H
+
+#include <cmath>
+
+#if defined(VECTORMATH_SCALAR)
+// scalar code only
+#elif defined(__AVX__)
+#define VECTORMATH_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTORMATH_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VECTORMATH_NEON
+#include <arm_neon.h>
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// SIMD lanes of floats; only the operations the batch functions need
+///////////////////////////////////////////////////////////////////////////////
+namespace simd
+{
+#if defined(VECTORMATH_AVX)
+    typedef __m256 Float;
+    const int WIDTH = 8;
+    const char* const NAME = "AVX";
+    inline Float load(const float* p)               { return _mm256_loadu_ps(p); }
+    inline void  store(float* p, Float a)           { _mm256_storeu_ps(p, a); }
+    inline Float set(float s)                       { return _mm256_set1_ps(s); }
+    inline Float add(Float a, Float b)              { return _mm256_add_ps(a, b); }
+    inline Float sub(Float a, Float b)              { return _mm256_sub_ps(a, b); }
+    inline Float mul(Float a, Float b)              { return _mm256_mul_ps(a, b); }
+    inline Float div(Float a, Float b)              { return _mm256_div_ps(a, b); }
+    inline Float sqrt(Float a)                      { return _mm256_sqrt_ps(a); }
+    inline Float minimum(Float a, Float b)          { return _mm256_min_ps(a, b); }
+    inline Float maximum(Float a, Float b)          { return _mm256_max_ps(a, b); }
+    // transpose 4 vectors and store element k as 4 floats at out + k * stride
+    inline void storeTransposed4(float* out, int stride, Float a, Float b, Float c, Float d)
+    {
+        __m256 ab0 = _mm256_unpacklo_ps(a, b);      // a0 b0 a1 b1 | a4 b4 a5 b5
+        __m256 ab1 = _mm256_unpackhi_ps(a, b);      // a2 b2 a3 b3 | a6 b6 a7 b7
+        __m256 cd0 = _mm256_unpacklo_ps(c, d);
+        __m256 cd1 = _mm256_unpackhi_ps(c, d);
+        __m256 r0 = _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(1, 0, 1, 0));  // element 0 | 4
+        __m256 r1 = _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(3, 2, 3, 2));  // element 1 | 5
+        __m256 r2 = _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(1, 0, 1, 0));  // element 2 | 6
+        __m256 r3 = _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(3, 2, 3, 2));  // element 3 | 7
+        _mm_storeu_ps(out,              _mm256_castps256_ps128(r0));
+        _mm_storeu_ps(out + stride,     _mm256_castps256_ps128(r1));
+        _mm_storeu_ps(out + stride * 2, _mm256_castps256_ps128(r2));
+        _mm_storeu_ps(out + stride * 3, _mm256_castps256_ps128(r3));
+        _mm_storeu_ps(out + stride * 4, _mm256_extractf128_ps(r0, 1));
+        _mm_storeu_ps(out + stride * 5, _mm256_extractf128_ps(r1, 1));
+        _mm_storeu_ps(out + stride * 6, _mm256_extractf128_ps(r2, 1));
+        _mm_storeu_ps(out + stride * 7, _mm256_extractf128_ps(r3, 1));
+    }
+#elif defined(VECTORMATH_SSE)
+    typedef __m128 Float;
+    const int WIDTH = 4;
+    const char* const NAME = "SSE";
+    inline Float load(const float* p)               { return _mm_loadu_ps(p); }
+    inline void  store(float* p, Float a)           { _mm_storeu_ps(p, a); }
+    inline Float set(float s)                       { return _mm_set1_ps(s); }
+    inline Float add(Float a, Float b)              { return _mm_add_ps(a, b); }
+    inline Float sub(Float a, Float b)              { return _mm_sub_ps(a, b); }
+    inline Float mul(Float a, Float b)              { return _mm_mul_ps(a, b); }
+    inline Float div(Float a, Float b)              { return _mm_div_ps(a, b); }
+    inline Float sqrt(Float a)                      { return _mm_sqrt_ps(a); }
+    inline Float minimum(Float a, Float b)          { return _mm_min_ps(a, b); }
+    inline Float maximum(Float a, Float b)          { return _mm_max_ps(a, b); }
+    inline void storeTransposed4(float* out, int stride, Float a, Float b, Float c, Float d)
+    {
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_storeu_ps(out, a);
+        _mm_storeu_ps(out + stride, b);
+        _mm_storeu_ps(out + stride * 2, c);
+        _mm_storeu_ps(out + stride * 3, d);
+    }
+#elif defined(VECTORMATH_NEON)
+    typedef float32x4_t Float;
+    const int WIDTH = 4;
+    const char* const NAME = "NEON";
+    inline Float load(const float* p)               { return vld1q_f32(p); }
+    inline void  store(float* p, Float a)           { vst1q_f32(p, a); }
+    inline Float set(float s)                       { return vdupq_n_f32(s); }
+    inline Float add(Float a, Float b)              { return vaddq_f32(a, b); }
+    inline Float sub(Float a, Float b)              { return vsubq_f32(a, b); }
+    inline Float mul(Float a, Float b)              { return vmulq_f32(a, b); }
+    inline Float minimum(Float a, Float b)          { return vminq_f32(a, b); }
+    inline Float maximum(Float a, Float b)          { return vmaxq_f32(a, b); }
+    inline void storeTransposed4(float* out, int stride, Float a, Float b, Float c, Float d)
+    {
+        float32x4x2_t ac = vzipq_f32(a, c);         // a0 c0 a1 c1, a2 c2 a3 c3
+        float32x4x2_t bd = vzipq_f32(b, d);
+        float32x4x2_t lo = vzipq_f32(ac.val[0], bd.val[0]);
+        float32x4x2_t hi = vzipq_f32(ac.val[1], bd.val[1]);
+        vst1q_f32(out, lo.val[0]);
+        vst1q_f32(out + stride, lo.val[1]);
+        vst1q_f32(out + stride * 2, hi.val[0]);
+        vst1q_f32(out + stride * 3, hi.val[1]);
+    }
+#if defined(__aarch64__)
+    inline Float div(Float a, Float b)              { return vdivq_f32(a, b); }
+    inline Float sqrt(Float a)                      { return vsqrtq_f32(a); }
+#else
+    // ARMv7 has only estimates; refine with 2 Newton-Raphson steps
+    inline Float div(Float a, Float b)
+    {
+        Float r = vrecpeq_f32(b);
+        r = vmulq_f32(r, vrecpsq_f32(b, r));
+        r = vmulq_f32(r, vrecpsq_f32(b, r));
+        return vmulq_f32(a, r);
+    }
+    inline Float sqrt(Float a)
+    {
+        Float r = vrsqrteq_f32(a);
+        r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r));
+        r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r));
+        return vbslq_f32(vceqq_f32(a, vdupq_n_f32(0)), a, vmulq_f32(a, r));  // sqrt(0) = 0
+    }
+#endif
+#else
+    typedef float Float;
+    const int WIDTH = 1;
+    const char* const NAME = "scalar";
+    inline Float load(const float* p)               { return *p; }
+    inline void  store(float* p, Float a)           { *p = a; }
+    inline Float set(float s)                       { return s; }
+    inline Float add(Float a, Float b)              { return a + b; }
+    inline Float sub(Float a, Float b)              { return a - b; }
+    inline Float mul(Float a, Float b)              { return a * b; }
+    inline Float div(Float a, Float b)              { return a / b; }
+    inline Float sqrt(Float a)                      { return std::sqrt(a); }
+    inline Float minimum(Float a, Float b)          { return a < b ? a : b; }
+    inline Float maximum(Float a, Float b)          { return a > b ? a : b; }
+    inline void storeTransposed4(float* out, int, Float a, Float b, Float c, Float d)
+    {
+        out[0] = a; out[1] = b; out[2] = c; out[3] = d;
+    }
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 3D vector
+///////////////////////////////////////////////////////////////////////////////
+struct Vec3
+{
+    float x, y, z;
+
+    Vec3() : x(0), y(0), z(0)                                       {}
+    Vec3(float x, float y, float z) : x(x), y(y), z(z)              {}
+    explicit Vec3(const float* v) : x(v[0]), y(v[1]), z(v[2])       {}
+
+    void set(float x, float y, float z)             { this->x = x; this->y = y; this->z = z; }
+    void copyTo(float* v) const                     { v[0] = x; v[1] = y; v[2] = z; }
+
+    Vec3  operator-() const                         { return Vec3(-x, -y, -z); }
+    Vec3  operator+(const Vec3& v) const            { return Vec3(x + v.x, y + v.y, z + v.z); }
+    Vec3  operator-(const Vec3& v) const            { return Vec3(x - v.x, y - v.y, z - v.z); }
+    Vec3  operator*(float s) const                  { return Vec3(x * s, y * s, z * s); }
+    Vec3& operator+=(const Vec3& v)                 { x += v.x; y += v.y; z += v.z; return *this; }
+    Vec3& operator-=(const Vec3& v)                 { x -= v.x; y -= v.y; z -= v.z; return *this; }
+    Vec3& operator*=(float s)                       { x *= s; y *= s; z *= s; return *this; }
+};
+
+inline Vec3  operator*(float s, const Vec3& v)      { return v * s; }
+inline float dot(const Vec3& a, const Vec3& b)      { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3  cross(const Vec3& a, const Vec3& b)    { return Vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x); }
+inline float length(const Vec3& v)                  { return std::sqrt(dot(v, v)); }
+
+// return unit vector, or the input if its length is 0
+inline Vec3 normalize(const Vec3& v)
+{
+    float len = length(v);
+    return len > 0 ? v * (1.0f / len) : v;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 4D vector, also used for planes (xyz: normal, w: distance)
+///////////////////////////////////////////////////////////////////////////////
+struct Vec4
+{
+    float x, y, z, w;
+
+    Vec4() : x(0), y(0), z(0), w(0)                                 {}
+    Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    Vec4(const Vec3& v, float w) : x(v.x), y(v.y), z(v.z), w(w)    {}
+    explicit Vec4(const float* v) : x(v[0]), y(v[1]), z(v[2]), w(v[3]) {}
+
+    Vec3  xyz() const                               { return Vec3(x, y, z); }
+
+    Vec4  operator+(const Vec4& v) const            { return Vec4(x + v.x, y + v.y, z + v.z, w + v.w); }
+    Vec4  operator-(const Vec4& v) const            { return Vec4(x - v.x, y - v.y, z - v.z, w - v.w); }
+    Vec4  operator*(float s) const                  { return Vec4(x * s, y * s, z * s, w * s); }
+};
+
+inline float dot(const Vec4& a, const Vec4& b)      { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// rotation quaternion
+///////////////////////////////////////////////////////////////////////////////
+struct Quat
+{
+    float x, y, z, w;
+
+    Quat() : x(0), y(0), z(0), w(1)                                 {}
+    Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    explicit Quat(const float* q) : x(q[0]), y(q[1]), z(q[2]), w(q[3]) {}
+
+    void  copyTo(float* q) const                    { q[0] = x; q[1] = y; q[2] = z; q[3] = w; }
+    Vec3  axis() const                              { return Vec3(x, y, z); }
+    Quat  conjugate() const                         { return Quat(-x, -y, -z, w); }
+
+    // compose rotations; (a * b) rotates by b first, then a
+    Quat operator*(const Quat& q) const
+    {
+        return Quat(w * q.x + q.w * x + y * q.z - z * q.y,
+                    w * q.y + q.w * y + z * q.x - x * q.z,
+                    w * q.z + q.w * z + x * q.y - y * q.x,
+                    w * q.w - x * q.x - y * q.y - z * q.z);
+    }
+
+    // rotation of angle (radian) about axis, axis need not be unit length
+    static Quat fromAxisAngle(const Vec3& axis, float angle)
+    {
+        Vec3 v = normalize(axis) * std::sin(angle * 0.5f);
+        return Quat(v.x, v.y, v.z, std::cos(angle * 0.5f));
+    }
+};
+
+inline float dot(const Quat& a, const Quat& b)      { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+// divide by magnitude to make it unit quaternion again
+inline Quat normalize(const Quat& q)
+{
+    float len = std::sqrt(dot(q, q));
+    if(len <= 0)
+        return Quat();
+    float inv = 1.0f / len;
+    return Quat(q.x * inv, q.y * inv, q.z * inv, q.w * inv);
+}
+
+// pull a nearly unit quaternion back to unit length without sqrt/division
+// It is the first-order correction q * (3 - |q|^2) / 2; the error after it is
+// about the square of the error before, so repeated composition stays at
+// float precision.
+inline Quat renormalize(const Quat& q)
+{
+    float k = 1.5f - 0.5f * dot(q, q);
+    return Quat(q.x * k, q.y * k, q.z * k, q.w * k);
+}
+
+// compose rotations (a * b) and renormalize the result
+// It has no state, so it is safe to call from many threads at once.
+inline Quat compose(const Quat& a, const Quat& b)
+{
+    return renormalize(a * b);
+}
+
+// rotate vector v by unit quaternion q
+inline Vec3 rotate(const Quat& q, const Vec3& v)
+{
+    Vec3 u = q.axis();
+    Vec3 t = cross(u, v) * 2.0f;
+    return v + t * q.w + cross(u, t);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 4x4 matrix, column-major
+///////////////////////////////////////////////////////////////////////////////
+struct Mat4
+{
+    float m[16];
+
+    Mat4()                                          { identity(); }
+    explicit Mat4(const float* src)                 { for(int i = 0; i < 16; ++i) m[i] = src[i]; }
+
+    void identity()
+    {
+        for(int i = 0; i < 16; ++i)
+            m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+
+    float& at(int row, int col)                     { return m[col * 4 + row]; }
+    float  at(int row, int col) const               { return m[col * 4 + row]; }
+    const float* get() const                        { return m; }
+
+    Mat4 transpose() const
+    {
+        Mat4 t;
+        for(int c = 0; c < 4; ++c)
+            for(int r = 0; r < 4; ++r)
+                t.m[r * 4 + c] = m[c * 4 + r];
+        return t;
+    }
+
+    Mat4 operator*(const Mat4& rhs) const
+    {
+        Mat4 p;
+        for(int c = 0; c < 4; ++c)
+        {
+            for(int r = 0; r < 4; ++r)
+            {
+                p.m[c * 4 + r] = m[r]      * rhs.m[c * 4]     + m[4 + r]  * rhs.m[c * 4 + 1] +
+                                 m[8 + r]  * rhs.m[c * 4 + 2] + m[12 + r] * rhs.m[c * 4 + 3];
+            }
+        }
+        return p;
+    }
+
+    Vec4 operator*(const Vec4& v) const
+    {
+        return Vec4(m[0] * v.x + m[4] * v.y + m[8]  * v.z + m[12] * v.w,
+                    m[1] * v.x + m[5] * v.y + m[9]  * v.z + m[13] * v.w,
+                    m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14] * v.w,
+                    m[3] * v.x + m[7] * v.y + m[11] * v.z + m[15] * v.w);
+    }
+
+    // transform point (w = 1), no perspective divide
+    Vec3 transformPoint(const Vec3& v) const
+    {
+        return Vec3(m[0] * v.x + m[4] * v.y + m[8]  * v.z + m[12],
+                    m[1] * v.x + m[5] * v.y + m[9]  * v.z + m[13],
+                    m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14]);
+    }
+
+    static Mat4 translation(float x, float y, float z)
+    {
+        Mat4 t;
+        t.m[12] = x;
+        t.m[13] = y;
+        t.m[14] = z;
+        return t;
+    }
+
+    // same as gluLookAt()
+    static Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+    {
+        Vec3 f = normalize(target - eye);           // forward
+        Vec3 s = normalize(cross(f, up));           // side (right)
+        Vec3 u = cross(s, f);                       // recomputed up
+        Mat4 v;
+        v.m[0] = s.x;  v.m[4] = s.y;  v.m[8]  = s.z;  v.m[12] = -dot(s, eye);
+        v.m[1] = u.x;  v.m[5] = u.y;  v.m[9]  = u.z;  v.m[13] = -dot(u, eye);
+        v.m[2] = -f.x; v.m[6] = -f.y; v.m[10] = -f.z; v.m[14] = dot(f, eye);
+        return v;
+    }
+
+    // same as gluPerspective(), fovY in degree
+    static Mat4 perspective(float fovY, float aspect, float nearZ, float farZ)
+    {
+        float f = 1.0f / std::tan(fovY * 0.5f * 3.14159265f / 180.0f);
+        Mat4 p;
+        p.m[0] = f / aspect;
+        p.m[5] = f;
+        p.m[10] = (farZ + nearZ) / (nearZ - farZ);
+        p.m[11] = -1.0f;
+        p.m[14] = 2.0f * farZ * nearZ / (nearZ - farZ);
+        p.m[15] = 0.0f;
+        return p;
+    }
+
+    static Mat4 rotation(const Quat& q)
+    {
+        float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        Mat4 r;
+        r.m[0] = 1 - 2 * (yy + zz);  r.m[4] = 2 * (xy - wz);      r.m[8]  = 2 * (xz + wy);
+        r.m[1] = 2 * (xy + wz);      r.m[5] = 1 - 2 * (xx + zz);  r.m[9]  = 2 * (yz - wx);
+        r.m[2] = 2 * (xz - wy);      r.m[6] = 2 * (yz + wx);      r.m[10] = 1 - 2 * (xx + yy);
+        return r;
+    }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch functions over SoA arrays
+// Output arrays may be the same as input arrays.
+///////////////////////////////////////////////////////////////////////////////
+struct Vec3SoA
+{
+    float* x;
+    float* y;
+    float* z;
+
+    Vec3SoA() : x(0), y(0), z(0)                                    {}
+    Vec3SoA(float* x, float* y, float* z) : x(x), y(y), z(z)        {}
+};
+
+struct QuatSoA
+{
+    float* x;
+    float* y;
+    float* z;
+    float* w;
+
+    QuatSoA() : x(0), y(0), z(0), w(0)                              {}
+    QuatSoA(float* x, float* y, float* z, float* w) : x(x), y(y), z(z), w(w) {}
+};
+
+// out = a + b
+inline void batchAdd(const Vec3SoA& a, const Vec3SoA& b, const Vec3SoA& out, int count)
+{
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::store(out.x + i, simd::add(simd::load(a.x + i), simd::load(b.x + i)));
+        simd::store(out.y + i, simd::add(simd::load(a.y + i), simd::load(b.y + i)));
+        simd::store(out.z + i, simd::add(simd::load(a.z + i), simd::load(b.z + i)));
+    }
+    for(; i < count; ++i)
+    {
+        out.x[i] = a.x[i] + b.x[i];
+        out.y[i] = a.y[i] + b.y[i];
+        out.z[i] = a.z[i] + b.z[i];
+    }
+}
+
+// out = a - b
+inline void batchSub(const Vec3SoA& a, const Vec3SoA& b, const Vec3SoA& out, int count)
+{
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::store(out.x + i, simd::sub(simd::load(a.x + i), simd::load(b.x + i)));
+        simd::store(out.y + i, simd::sub(simd::load(a.y + i), simd::load(b.y + i)));
+        simd::store(out.z + i, simd::sub(simd::load(a.z + i), simd::load(b.z + i)));
+    }
+    for(; i < count; ++i)
+    {
+        out.x[i] = a.x[i] - b.x[i];
+        out.y[i] = a.y[i] - b.y[i];
+        out.z[i] = a.z[i] - b.z[i];
+    }
+}
+
+// out = v * s
+inline void batchScale(const Vec3SoA& v, float s, const Vec3SoA& out, int count)
+{
+    simd::Float vs = simd::set(s);
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::store(out.x + i, simd::mul(simd::load(v.x + i), vs));
+        simd::store(out.y + i, simd::mul(simd::load(v.y + i), vs));
+        simd::store(out.z + i, simd::mul(simd::load(v.z + i), vs));
+    }
+    for(; i < count; ++i)
+    {
+        out.x[i] = v.x[i] * s;
+        out.y[i] = v.y[i] * s;
+        out.z[i] = v.z[i] * s;
+    }
+}
+
+// out[i] = dot(a[i], b[i])
+inline void batchDot(const Vec3SoA& a, const Vec3SoA& b, float* out, int count)
+{
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float d = simd::mul(simd::load(a.x + i), simd::load(b.x + i));
+        d = simd::add(d, simd::mul(simd::load(a.y + i), simd::load(b.y + i)));
+        d = simd::add(d, simd::mul(simd::load(a.z + i), simd::load(b.z + i)));
+        simd::store(out + i, d);
+    }
+    for(; i < count; ++i)
+        out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+}
+
+// out = cross(a, b)
+inline void batchCross(const Vec3SoA& a, const Vec3SoA& b, const Vec3SoA& out, int count)
+{
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float ax = simd::load(a.x + i), ay = simd::load(a.y + i), az = simd::load(a.z + i);
+        simd::Float bx = simd::load(b.x + i), by = simd::load(b.y + i), bz = simd::load(b.z + i);
+        simd::store(out.x + i, simd::sub(simd::mul(ay, bz), simd::mul(az, by)));
+        simd::store(out.y + i, simd::sub(simd::mul(az, bx), simd::mul(ax, bz)));
+        simd::store(out.z + i, simd::sub(simd::mul(ax, by), simd::mul(ay, bx)));
+    }
+    for(; i < count; ++i)
+    {
+        Vec3 c = cross(Vec3(a.x[i], a.y[i], a.z[i]), Vec3(b.x[i], b.y[i], b.z[i]));
+        out.x[i] = c.x;
+        out.y[i] = c.y;
+        out.z[i] = c.z;
+    }
+}
+
+// out[i] = length(v[i])
+inline void batchLength(const Vec3SoA& v, float* out, int count)
+{
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float x = simd::load(v.x + i), y = simd::load(v.y + i), z = simd::load(v.z + i);
+        simd::store(out + i, simd::sqrt(simd::add(simd::add(simd::mul(x, x), simd::mul(y, y)), simd::mul(z, z))));
+    }
+    for(; i < count; ++i)
+        out[i] = std::sqrt(v.x[i] * v.x[i] + v.y[i] * v.y[i] + v.z[i] * v.z[i]);
+}
+
+// out = normalize(v); zero-length vectors stay zero
+inline void batchNormalize(const Vec3SoA& v, const Vec3SoA& out, int count)
+{
+    const simd::Float tiny = simd::set(1e-30f);
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float x = simd::load(v.x + i), y = simd::load(v.y + i), z = simd::load(v.z + i);
+        simd::Float len = simd::sqrt(simd::add(simd::add(simd::mul(x, x), simd::mul(y, y)), simd::mul(z, z)));
+        len = simd::maximum(len, tiny);
+        simd::store(out.x + i, simd::div(x, len));
+        simd::store(out.y + i, simd::div(y, len));
+        simd::store(out.z + i, simd::div(z, len));
+    }
+    for(; i < count; ++i)
+    {
+        Vec3 n = normalize(Vec3(v.x[i], v.y[i], v.z[i]));
+        out.x[i] = n.x;
+        out.y[i] = n.y;
+        out.z[i] = n.z;
+    }
+}
+
+// out = m * (v, 1), without perspective divide
+inline void batchTransformPoints(const Mat4& m, const Vec3SoA& v, const Vec3SoA& out, int count)
+{
+    const float* a = m.m;
+    simd::Float m0 = simd::set(a[0]), m4 = simd::set(a[4]), m8  = simd::set(a[8]),  m12 = simd::set(a[12]);
+    simd::Float m1 = simd::set(a[1]), m5 = simd::set(a[5]), m9  = simd::set(a[9]),  m13 = simd::set(a[13]);
+    simd::Float m2 = simd::set(a[2]), m6 = simd::set(a[6]), m10 = simd::set(a[10]), m14 = simd::set(a[14]);
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float x = simd::load(v.x + i), y = simd::load(v.y + i), z = simd::load(v.z + i);
+        simd::store(out.x + i, simd::add(simd::add(simd::mul(m0, x), simd::mul(m4, y)), simd::add(simd::mul(m8, z), m12)));
+        simd::store(out.y + i, simd::add(simd::add(simd::mul(m1, x), simd::mul(m5, y)), simd::add(simd::mul(m9, z), m13)));
+        simd::store(out.z + i, simd::add(simd::add(simd::mul(m2, x), simd::mul(m6, y)), simd::add(simd::mul(m10, z), m14)));
+    }
+    for(; i < count; ++i)
+    {
+        Vec3 p = m.transformPoint(Vec3(v.x[i], v.y[i], v.z[i]));
+        out.x[i] = p.x;
+        out.y[i] = p.y;
+        out.z[i] = p.z;
+    }
+}
+
+// out[i] = signed distance from plane (xyz: unit normal, w: offset) to point
+inline void batchPlaneDistance(const Vec4& plane, const Vec3SoA& v, float* out, int count)
+{
+    simd::Float px = simd::set(plane.x), py = simd::set(plane.y), pz = simd::set(plane.z), pw = simd::set(plane.w);
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float d = simd::add(simd::mul(px, simd::load(v.x + i)), simd::mul(py, simd::load(v.y + i)));
+        d = simd::add(d, simd::add(simd::mul(pz, simd::load(v.z + i)), pw));
+        simd::store(out + i, d);
+    }
+    for(; i < count; ++i)
+        out[i] = plane.x * v.x[i] + plane.y * v.y[i] + plane.z * v.z[i] + plane.w;
+}
+
+// test bounding spheres against planes facing inward (e.g. 6 frustum planes)
+// visible[i] is set to 1 if sphere i is not completely outside of any plane.
+// It returns the number of visible spheres.
+inline int batchCullSpheres(const Vec4* planes, int planeCount, const Vec3SoA& centers, const float* radii,
+                            unsigned char* visible, int count)
+{
+    int visibleCount = 0;
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float x = simd::load(centers.x + i), y = simd::load(centers.y + i), z = simd::load(centers.z + i);
+        simd::Float r = simd::load(radii + i);
+        simd::Float nearest = simd::set(1e30f);     // min of (distance + radius) over planes
+        for(int p = 0; p < planeCount; ++p)
+        {
+            simd::Float d = simd::add(simd::mul(simd::set(planes[p].x), x), simd::mul(simd::set(planes[p].y), y));
+            d = simd::add(d, simd::add(simd::mul(simd::set(planes[p].z), z), simd::set(planes[p].w)));
+            nearest = simd::minimum(nearest, simd::add(d, r));
+        }
+        float lanes[simd::WIDTH];
+        simd::store(lanes, nearest);
+        for(int k = 0; k < simd::WIDTH; ++k)
+        {
+            visible[i + k] = lanes[k] >= 0 ? 1 : 0;
+            visibleCount += visible[i + k];
+        }
+    }
+    for(; i < count; ++i)
+    {
+        Vec3 c(centers.x[i], centers.y[i], centers.z[i]);
+        visible[i] = 1;
+        for(int p = 0; p < planeCount; ++p)
+        {
+            if(dot(planes[p].xyz(), c) + planes[p].w + radii[i] < 0)
+            {
+                visible[i] = 0;
+                break;
+            }
+        }
+        visibleCount += visible[i];
+    }
+    return visibleCount;
+}
+
+
+
+// out = compose(a, b) for each element; out may be the same as a or b
+inline void batchCompose(const QuatSoA& a, const QuatSoA& b, const QuatSoA& out, int count)
+{
+    const simd::Float half = simd::set(0.5f);
+    const simd::Float oneHalf = simd::set(1.5f);
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float ax = simd::load(a.x + i), ay = simd::load(a.y + i), az = simd::load(a.z + i), aw = simd::load(a.w + i);
+        simd::Float bx = simd::load(b.x + i), by = simd::load(b.y + i), bz = simd::load(b.z + i), bw = simd::load(b.w + i);
+
+        simd::Float x = simd::add(simd::add(simd::mul(aw, bx), simd::mul(bw, ax)), simd::sub(simd::mul(ay, bz), simd::mul(az, by)));
+        simd::Float y = simd::add(simd::add(simd::mul(aw, by), simd::mul(bw, ay)), simd::sub(simd::mul(az, bx), simd::mul(ax, bz)));
+        simd::Float z = simd::add(simd::add(simd::mul(aw, bz), simd::mul(bw, az)), simd::sub(simd::mul(ax, by), simd::mul(ay, bx)));
+        simd::Float w = simd::sub(simd::sub(simd::mul(aw, bw), simd::mul(ax, bx)), simd::add(simd::mul(ay, by), simd::mul(az, bz)));
+
+        simd::Float len2 = simd::add(simd::add(simd::mul(x, x), simd::mul(y, y)), simd::add(simd::mul(z, z), simd::mul(w, w)));
+        simd::Float k = simd::sub(oneHalf, simd::mul(half, len2));
+        simd::store(out.x + i, simd::mul(x, k));
+        simd::store(out.y + i, simd::mul(y, k));
+        simd::store(out.z + i, simd::mul(z, k));
+        simd::store(out.w + i, simd::mul(w, k));
+    }
+    for(; i < count; ++i)
+    {
+        Quat q = compose(Quat(a.x[i], a.y[i], a.z[i], a.w[i]), Quat(b.x[i], b.y[i], b.z[i], b.w[i]));
+        out.x[i] = q.x;
+        out.y[i] = q.y;
+        out.z[i] = q.z;
+        out.w[i] = q.w;
+    }
+}
+
+
+
+// build instance matrices from unit quaternions, translations and uniform
+// scales. Each matrix is written as 12 floats, the top 3 rows of the 4x4
+// column-major matrix (translation in the last element of each row):
+// out[i*12 + r*4 + c] = (R * s)[r][c], out[i*12 + r*4 + 3] = t[r]
+// It is the same rotation as Mat4::rotation(), but does all math in float
+// and writes each row of WIDTH matrices with a transposed store, so out can
+// be mapped (write-combined) buffer memory.
+inline void batchQuatToMatrix(const QuatSoA& q, const Vec3SoA& t, const float* s, float* out, int count)
+{
+    const simd::Float two = simd::set(2.0f);
+    int i = 0;
+    for(; i + simd::WIDTH <= count; i += simd::WIDTH)
+    {
+        simd::Float x = simd::load(q.x + i), y = simd::load(q.y + i), z = simd::load(q.z + i), w = simd::load(q.w + i);
+        simd::Float sc = simd::load(s + i);
+        simd::Float s2 = simd::mul(two, sc);
+        simd::Float xx = simd::mul(x, x), yy = simd::mul(y, y), zz = simd::mul(z, z);
+        simd::Float xy = simd::mul(x, y), xz = simd::mul(x, z), yz = simd::mul(y, z);
+        simd::Float wx = simd::mul(w, x), wy = simd::mul(w, y), wz = simd::mul(w, z);
+
+        // (1 - 2a) * s = s - 2s * a
+        simd::Float m00 = simd::sub(sc, simd::mul(s2, simd::add(yy, zz)));
+        simd::Float m01 = simd::mul(s2, simd::sub(xy, wz));
+        simd::Float m02 = simd::mul(s2, simd::add(xz, wy));
+        simd::Float m10 = simd::mul(s2, simd::add(xy, wz));
+        simd::Float m11 = simd::sub(sc, simd::mul(s2, simd::add(xx, zz)));
+        simd::Float m12 = simd::mul(s2, simd::sub(yz, wx));
+        simd::Float m20 = simd::mul(s2, simd::sub(xz, wy));
+        simd::Float m21 = simd::mul(s2, simd::add(yz, wx));
+        simd::Float m22 = simd::sub(sc, simd::mul(s2, simd::add(xx, yy)));
+
+        float* dst = out + i * 12;
+        simd::storeTransposed4(dst,     12, m00, m01, m02, simd::load(t.x + i));
+        simd::storeTransposed4(dst + 4, 12, m10, m11, m12, simd::load(t.y + i));
+        simd::storeTransposed4(dst + 8, 12, m20, m21, m22, simd::load(t.z + i));
+    }
+    for(; i < count; ++i)
+    {
+        float x = q.x[i], y = q.y[i], z = q.z[i], w = q.w[i];
+        float sc = s[i], s2 = 2.0f * s[i];
+        float* dst = out + i * 12;
+        dst[0] = sc - s2 * (y * y + z * z);
+        dst[1] = s2 * (x * y - w * z);
+        dst[2] = s2 * (x * z + w * y);
+        dst[3] = t.x[i];
+        dst[4] = s2 * (x * y + w * z);
+        dst[5] = sc - s2 * (x * x + z * z);
+        dst[6] = s2 * (y * z - w * x);
+        dst[7] = t.y[i];
+        dst[8] = s2 * (x * z - w * y);
+        dst[9] = s2 * (y * z + w * x);
+        dst[10] = sc - s2 * (x * x + y * y);
+        dst[11] = t.z[i];
+    }
+}
+
+#endif
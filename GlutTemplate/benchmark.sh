@@ -0,0 +1,60 @@
+#!/bin/sh
+###############################################################################
+# benchmark.sh
+# ============
+# object-count scaling sweep with the headless mode of vboCube
+#
+# Runs every draw method at 1k, 2k, 4k ... objects up to MAX_OBJECTS, plus
+# the default 40k scene, one process per run so peak RSS is per run. Each
+# run appends a row to the CSV (mean/p99 frame ms, CPU/GPU mean ms, draw
+# calls, bytes of instance data sent per frame, peak RSS in KB) and writes
+# its full JSON report into REPORT_DIR.
+#
+# usage: ./benchmark.sh [output.csv]
+#   FRAMES=60 MAX_OBJECTS=1024000 METHODS="instanced per-object" ./benchmark.sh
+#
+# CREATED: 2026-10-18
+# UPDATED: 2026-10-18
+###############################################################################
+
+cd "$(dirname "$0")" || exit 1
+
+BIN=${BIN:-../bin/vboCube}
+OUT=${1:-sweep.csv}
+FRAMES=${FRAMES:-60}
+MAX_OBJECTS=${MAX_OBJECTS:-1024000}
+METHODS=${METHODS:-"instanced per-object"}
+REPORT_DIR=${REPORT_DIR:-sweep_reports}
+
+if [ ! -x "$BIN" ]; then
+    echo "[ERROR] $BIN not found, build it first with: make -f Makefile.linux"
+    exit 1
+fi
+
+# doubling from 1k, with 40k (200 x 200 grid) inserted in order
+COUNTS=""
+n=1000
+while [ $n -le $MAX_OBJECTS ]; do
+    if [ $n -gt 40000 ] && [ $((n / 2)) -lt 40000 ]; then
+        COUNTS="$COUNTS 40000"
+    fi
+    COUNTS="$COUNTS $n"
+    n=$((n * 2))
+done
+
+rm -f "$OUT"
+mkdir -p "$REPORT_DIR"
+failed=0
+for method in $METHODS; do
+    for count in $COUNTS; do
+        echo "== $method, $count objects"
+        if ! "$BIN" --headless "$FRAMES" --draw "$method" --objects "$count" \
+                    --report "$REPORT_DIR/${method}_${count}.json" --csv "$OUT" > /dev/null; then
+            echo "[WARNING] run failed: $method, $count objects"
+            failed=1
+        fi
+    done
+done
+
+echo "Wrote $OUT"
+exit $failed
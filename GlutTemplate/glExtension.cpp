@@ -19,6 +19,12 @@
 // GL_ARB_shader_objects, GL_ARB_vertex_program, GL_ARB_fragment_program, GL_ARB_vertex_shader, GL_ARB_fragment_shader
 // GL_ARB_sync
 // GL_ARB_vertex_array_object
+// GL_ARB_copy_buffer
+// GL_ARB_draw_instanced
+// GL_ARB_instanced_arrays
+// GL_ARB_map_buffer_range
+// GL_EXT_transform_feedback
+// GL_ARB_timer_query
 // WGL_ARB_extensions_string
 // WGL_ARB_pixel_format
 // WGL_ARB_create_context
@@ -311,6 +317,40 @@ PFNGLGETVERTEXATTRIBPOINTERVARBPROC     pglGetVertexAttribPointervARB = 0;
 PFNGLISPROGRAMARBPROC                   pglIsProgramARB = 0;
 */
 
+// GL_ARB_copy_buffer
+//@@ v3.1 core version
+PFNGLCOPYBUFFERSUBDATAPROC pglCopyBufferSubData = 0;  // copy data between buffer objects on GPU
+
+// GL_ARB_draw_instanced
+//@@ v3.1 core version
+PFNGLDRAWARRAYSINSTANCEDPROC   pglDrawArraysInstanced = 0;
+PFNGLDRAWELEMENTSINSTANCEDPROC pglDrawElementsInstanced = 0;
+
+// GL_ARB_instanced_arrays
+//@@ v3.3 core version
+PFNGLVERTEXATTRIBDIVISORPROC pglVertexAttribDivisor = 0;  // advance vertex attrib per instance
+
+// GL_ARB_map_buffer_range
+//@@ v3.0 core version
+PFNGLMAPBUFFERRANGEPROC         pglMapBufferRange = 0;          // map a sub-range of VBO
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC pglFlushMappedBufferRange = 0;  // flush a modified part of mapped range
+
+// GL_EXT_transform_feedback
+//@@ v3.0 core version
+PFNGLBEGINTRANSFORMFEEDBACKPROC    pglBeginTransformFeedback = 0;     // capture vertex outputs into buffers
+PFNGLENDTRANSFORMFEEDBACKPROC      pglEndTransformFeedback = 0;
+PFNGLBINDBUFFERBASEPROC            pglBindBufferBase = 0;             // bind VBO to indexed feedback binding
+PFNGLTRANSFORMFEEDBACKVARYINGSPROC pglTransformFeedbackVaryings = 0;  // select varyings to capture, before link
+
+// GL_ARB_timer_query
+//@@ v3.3 core version
+PFNGLGENQUERIESPROC          pglGenQueries = 0;           // query object for GPU time
+PFNGLDELETEQUERIESPROC       pglDeleteQueries = 0;
+PFNGLBEGINQUERYPROC          pglBeginQuery = 0;
+PFNGLENDQUERYPROC            pglEndQuery = 0;
+PFNGLGETQUERYOBJECTIVPROC    pglGetQueryObjectiv = 0;     // check if result is available
+PFNGLGETQUERYOBJECTUI64VPROC pglGetQueryObjectui64v = 0;  // 64-bit result in nanoseconds
+
 // GL_ARB_debug_output
 //@@ v4.3 core version
 PFNGLDEBUGMESSAGECONTROLPROC  pglDebugMessageControl = 0;
@@ -865,18 +905,51 @@ void glExtension::getFunctionPointers()
             glIsProgramARB                  = (PFNGLISPROGRAMARBPROC)wglGetProcAddress("glIsProgramARB");
             */
         }
-        else if(extensions[i] == "GL_ARB_debug_output")
+        else if(extensions[i] == "GL_ARB_copy_buffer")
+        {
+            glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)wglGetProcAddress("glCopyBufferSubData");
+        }
+        else if(extensions[i] == "GL_ARB_draw_instanced")
+        {
+            glDrawArraysInstanced   = (PFNGLDRAWARRAYSINSTANCEDPROC)wglGetProcAddress("glDrawArraysInstanced");
+            glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)wglGetProcAddress("glDrawElementsInstanced");
+        }
+        else if(extensions[i] == "GL_ARB_instanced_arrays")
+        {
+            glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)wglGetProcAddress("glVertexAttribDivisor");
+        }
+        else if(extensions[i] == "GL_ARB_map_buffer_range")
+        {
+            glMapBufferRange         = (PFNGLMAPBUFFERRANGEPROC)wglGetProcAddress("glMapBufferRange");
+            glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC)wglGetProcAddress("glFlushMappedBufferRange");
+        }
+        else if(extensions[i] == "GL_EXT_transform_feedback")
+        {
+            glBeginTransformFeedback    = (PFNGLBEGINTRANSFORMFEEDBACKPROC)wglGetProcAddress("glBeginTransformFeedback");
+            glEndTransformFeedback      = (PFNGLENDTRANSFORMFEEDBACKPROC)wglGetProcAddress("glEndTransformFeedback");
+            glBindBufferBase            = (PFNGLBINDBUFFERBASEPROC)wglGetProcAddress("glBindBufferBase");
+            glTransformFeedbackVaryings = (PFNGLTRANSFORMFEEDBACKVARYINGSPROC)wglGetProcAddress("glTransformFeedbackVaryings");
+        }
+        else if(extensions[i] == "GL_ARB_timer_query")
+        {
+            glGenQueries          = (PFNGLGENQUERIESPROC)wglGetProcAddress("glGenQueries");
+            glDeleteQueries       = (PFNGLDELETEQUERIESPROC)wglGetProcAddress("glDeleteQueries");
+            glBeginQuery          = (PFNGLBEGINQUERYPROC)wglGetProcAddress("glBeginQuery");
+            glEndQuery            = (PFNGLENDQUERYPROC)wglGetProcAddress("glEndQuery");
+            glGetQueryObjectiv    = (PFNGLGETQUERYOBJECTIVPROC)wglGetProcAddress("glGetQueryObjectiv");
+            glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64v");
+        }
+        else if(extensions[i] == "GL_ARB_debug_output" || extensions[i] == "GL_KHR_debug")
         {
             glDebugMessageControl   = (PFNGLDEBUGMESSAGECONTROLPROC)wglGetProcAddress("glDebugMessageControl");
             glDebugMessageInsert    = (PFNGLDEBUGMESSAGEINSERTPROC)wglGetProcAddress("glDebugMessageInsert");
             glDebugMessageCallback  = (PFNGLDEBUGMESSAGECALLBACKPROC)wglGetProcAddress("glDebugMessageCallback");
             glGetDebugMessageLog    = (PFNGLGETDEBUGMESSAGELOGPROC)wglGetProcAddress("glGetDebugMessageLog");
-            /*
+            // drivers with GL_ARB_debug_output only export the ARB names
             glDebugMessageControlARB  = (PFNGLDEBUGMESSAGECONTROLARBPROC)wglGetProcAddress("glDebugMessageControlARB");
             glDebugMessageInsertARB   = (PFNGLDEBUGMESSAGEINSERTARBPROC)wglGetProcAddress("glDebugMessageInsertARB");
             glDebugMessageCallbackARB = (PFNGLDEBUGMESSAGECALLBACKARBPROC)wglGetProcAddress("glDebugMessageCallbackARB");
             glGetDebugMessageLogARB   = (PFNGLGETDEBUGMESSAGELOGARBPROC)wglGetProcAddress("glGetDebugMessageLogARB");
-            */
         }
         else if(extensions[i] == "GL_ARB_direct_state_access")
         {
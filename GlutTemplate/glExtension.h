@@ -19,11 +19,20 @@
 // GL_ARB_shader_objects, GL_ARB_vertex_program, GL_ARB_fragment_program, GL_ARB_vertex_shader, GL_ARB_fragment_shader
 // GL_ARB_sync
 // GL_ARB_vertex_array_object
+// GL_ARB_copy_buffer
+// GL_ARB_draw_instanced
+// GL_ARB_instanced_arrays
+// GL_ARB_map_buffer_range
+// GL_EXT_transform_feedback
+// GL_ARB_timer_query
 // WGL_ARB_extensions_string
 // WGL_ARB_pixel_format
 // WGL_ARB_create_context
 // WGL_EXT_swap_control
 //
+// On other platforms, -DGL_CALL_COUNTING redirects the GL entry points to the
+// per-frame counters of GlCallCounter.h.
+//
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
 // UPDATED: 2018-08-09
@@ -595,6 +604,56 @@ extern PFNGLISPROGRAMARBPROC                    pglIsProgramARB;
 #define glIsProgramARB                          pglIsProgramARB
 */
 
+// GL_ARB_copy_buffer
+//@@ v3.1 core version
+extern PFNGLCOPYBUFFERSUBDATAPROC pglCopyBufferSubData;  // copy data between buffer objects on GPU
+#define glCopyBufferSubData       pglCopyBufferSubData
+
+// GL_ARB_draw_instanced
+//@@ v3.1 core version
+extern PFNGLDRAWARRAYSINSTANCEDPROC   pglDrawArraysInstanced;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC pglDrawElementsInstanced;
+#define glDrawArraysInstanced         pglDrawArraysInstanced
+#define glDrawElementsInstanced       pglDrawElementsInstanced
+
+// GL_ARB_instanced_arrays
+//@@ v3.3 core version
+extern PFNGLVERTEXATTRIBDIVISORPROC pglVertexAttribDivisor;  // advance vertex attrib per instance
+#define glVertexAttribDivisor       pglVertexAttribDivisor
+
+// GL_ARB_map_buffer_range
+//@@ v3.0 core version
+extern PFNGLMAPBUFFERRANGEPROC         pglMapBufferRange;          // map a sub-range of VBO
+extern PFNGLFLUSHMAPPEDBUFFERRANGEPROC pglFlushMappedBufferRange;  // flush a modified part of mapped range
+#define glMapBufferRange               pglMapBufferRange
+#define glFlushMappedBufferRange       pglFlushMappedBufferRange
+
+// GL_EXT_transform_feedback
+//@@ v3.0 core version
+extern PFNGLBEGINTRANSFORMFEEDBACKPROC    pglBeginTransformFeedback;     // capture vertex outputs into buffers
+extern PFNGLENDTRANSFORMFEEDBACKPROC      pglEndTransformFeedback;
+extern PFNGLBINDBUFFERBASEPROC            pglBindBufferBase;             // bind VBO to indexed feedback binding
+extern PFNGLTRANSFORMFEEDBACKVARYINGSPROC pglTransformFeedbackVaryings;  // select varyings to capture, before link
+#define glBeginTransformFeedback          pglBeginTransformFeedback
+#define glEndTransformFeedback            pglEndTransformFeedback
+#define glBindBufferBase                  pglBindBufferBase
+#define glTransformFeedbackVaryings       pglTransformFeedbackVaryings
+
+// GL_ARB_timer_query
+//@@ v3.3 core version
+extern PFNGLGENQUERIESPROC          pglGenQueries;           // query object for GPU time
+extern PFNGLDELETEQUERIESPROC       pglDeleteQueries;
+extern PFNGLBEGINQUERYPROC          pglBeginQuery;
+extern PFNGLENDQUERYPROC            pglEndQuery;
+extern PFNGLGETQUERYOBJECTIVPROC    pglGetQueryObjectiv;     // check if result is available
+extern PFNGLGETQUERYOBJECTUI64VPROC pglGetQueryObjectui64v;  // 64-bit result in nanoseconds
+#define glGenQueries                pglGenQueries
+#define glDeleteQueries             pglDeleteQueries
+#define glBeginQuery                pglBeginQuery
+#define glEndQuery                  pglEndQuery
+#define glGetQueryObjectiv          pglGetQueryObjectiv
+#define glGetQueryObjectui64v       pglGetQueryObjectui64v
+
 // GL_ARB_debug_output
 //@@ v4.3 core version
 extern PFNGLDEBUGMESSAGECONTROLPROC  pglDebugMessageControl;
@@ -845,4 +904,13 @@ extern PFNWGLGETSWAPINTERVALEXTPROC pwglGetSwapIntervalEXT;
 
 #endif //======================================================================
 
+
+
+// optional GL call counting on Linux =========================================
+// Build with -DGL_CALL_COUNTING to route the GL entry points through counting
+// wrappers, see GlCallCounter.h.
+#if defined(GL_CALL_COUNTING) && !defined(_WIN32)
+#include "GlCallCounter.h"
+#endif
+
 #endif // end of #ifndef
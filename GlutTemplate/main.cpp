@@ -17,13 +17,44 @@
 #else
 #include <GL/glut.h>
 #endif
+#if defined(FREEGLUT) && !defined(__APPLE__)
+#include <GL/freeglut_ext.h>            // glutInitContextFlags() for a debug context
+#endif
 
 #include <cstdlib>
+#include <cstdio>
+#include <cmath>
 #include <iostream>
-#include <sstream>
-#include <iomanip>
 #include <vector>
+#include <string>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 #include "glExtension.h"                // helper for OpenGL extensions
+#include "vbo.h"
+#include "shader.h"
+#include "InstanceBuffer.h"
+#include "DirtyRanges.h"
+#include "Simulation.h"
+#include "StepClock.h"
+#include "ParticleSystem.h"
+#include "VectorMath.h"
+#include "trackball.h"
+#include "Camera.h"
+#include "CameraPath.h"
+#include "TextRenderer.h"
+#include "LabelRenderer.h"
+#include "FrameStats.h"
+#include "GpuTimer.h"
+#include "HeadlessContext.h"
+#include "BenchmarkReport.h"
+#include "Profiler.h"
+#include "GlCallCounter.h"
+#include "GlCapture.h"
+#include "GlDebugOutput.h"
+#include "FramePacer.h"
+#include "BufferRegistry.h"
 
 
 // GLUT CALLBACK functions
@@ -44,14 +75,26 @@ int  initGLUT(int argc, char **argv);
 bool initSharedMem();
 void clearSharedMem();
 void initLights();
+bool initGLSL();
+void updateInstances();
+void drawObjects();
+void writeInstanceMatrices(void* dst, int first, int count, const void* userData);
 void setCamera(float posX, float posY, float posZ, float targetX, float targetY, float targetZ);
-GLuint createVBO(const void* data, int dataSize, GLenum target=GL_ARRAY_BUFFER, GLenum usage=GL_STATIC_DRAW);
-void deleteVBO(GLuint vboId);
-void drawString(const char *str, int x, int y, float color[4], void *font);
-void drawString3D(const char *str, float pos[3], float color[4], void *font);
+void updateTrackball();
+void drawLabels();
 void showInfo();
+void drawFrameGraph(int x, int y);
+void collectGpuTimes();
+bool isSceneIdle();
+bool runHeadless();
+long getPeakRss();
 void toOrtho();
 void toPerspective();
+void recordCameraKey(float time);
+void startRecording();
+void stopRecording();
+void startPlayback();
+void stopPlayback();
 
 
 // constants
@@ -60,10 +103,43 @@ const int   SCREEN_HEIGHT   = 600;
 const float CAMERA_DISTANCE = 15.0f;
 const int   TEXT_WIDTH      = 8;
 const int   TEXT_HEIGHT     = 13;
+const int   GRID_SIZE       = 200;      // GRID_SIZE x GRID_SIZE objects at startup
+const float GRID_SPACING    = 0.3f;
+const int   OBJECT_STEP     = 1000;     // number of objects added/removed per key press
+const double CAMERA_STEP    = 1.0 / 60; // seconds per camera step, camera turns g_eyeSpeed per step
+const int   PARTICLE_COUNT  = 256 * 1024;
+const float PARTICLE_SIZE   = 0.03f;    // diameter of particle sprite
+const int   MATRIX_FLOATS   = 12;       // 3x4 instance matrix per object
+const int   CONVERT_BATCH   = 256;      // objects gathered to SoA per batchQuatToMatrix() call
+const int   PATH_KEY_STEPS  = 30;       // camera steps between recorded keyframes
+const char* PATH_FILE       = "camera_path.txt";    // default file for recorded camera path
+const float LABEL_HEIGHT    = 0.1f;     // glyph height of object labels in world units
+const float LABEL_FADE_START = 4.0f;    // labels fade out between these distances
+const float LABEL_FADE_END  = 8.0f;
+const int   MAX_LABELS      = 4000;     // nearest labels drawn per frame
+const int   GRAPH_WIDTH     = 240;      // frame time graph, 1 pixel per frame
+const int   GRAPH_HEIGHT    = 80;
+const float GRAPH_SCALE     = 2.0f;     // pixels per millisecond
+const float FRAME_BUDGET    = 1000.0f / 60;     // ms
+const int   HEADLESS_FRAMES = 600;      // frames rendered by --headless without a count
+const int   WARMUP_FRAMES   = 10;       // frames before a headless run that are not reported
+const int   TRACE_FRAMES    = 120;      // frames saved to profiler trace per key press
+const char* TRACE_FILE      = "trace.json";     // Chrome trace-event file of profiler
+const char* REPORT_FILE     = "benchmark.json"; // default file for headless benchmark report
+const int   CAPTURE_FRAMES  = 60;       // frames written by --capture without a count
+const double TARGET_RATE    = 60;       // frames per second of frame pacer, the refresh rate for vsync
+
+
+// GPU passes of a frame, each measured with its own timer query
+enum GpuPass { GPU_CLEAR, GPU_SCENE, GPU_EFFECTS, GPU_HUD, GPU_SWAP, GPU_PASS_COUNT };
+const char* GPU_PASS_NAMES[GPU_PASS_COUNT] = { "clear", "scene", "effects", "hud", "swap" };
+
+// ways to draw the objects, selected with --draw for comparing how they scale
+enum DrawMethod { DRAW_INSTANCED, DRAW_PER_OBJECT, DRAW_METHOD_COUNT };
+const char* DRAW_METHOD_NAMES[DRAW_METHOD_COUNT] = { "instanced", "per-object" };
 
 
 // global variables
-void *font = GLUT_BITMAP_8_BY_13;
 GLuint vboId = 0;                   // ID of VBO for vertex arrays
 GLuint iboId = 0;                   // ID of VBO for index array
 int screenWidth;
@@ -84,12 +160,95 @@ bool updatePositions = true;
 
 float myClock = 0.0;
 float scale = 0.2;
-float myTime = 0;
-float fps = 0;
-float frames = 0;
-float base_time = 0;
+FrameStats frameStats;              // CPU/GPU frame times of recent frames
+GpuTimer gpuTimer;                  // GL_TIME_ELAPSED queries, results read a few frames later
+int phaseUpdate, phaseScene, phaseEffects, phaseHud, phaseSwap;     // CPU phases of a frame
+int frameDrawCalls = 0;             // draw calls issued in current frame
+long long frameTriangles = 0;       // triangles drawn in current frame
+long long frameUploadBytes = 0;     // instance data sent to GL in current frame
+DrawMethod drawMethod = DRAW_INSTANCED;
+int objectCount = GRID_SIZE * GRID_SIZE;    // objects at startup, set by --objects
+HeadlessContext headlessContext;    // EGL context and FBO instead of GLUT window
+BenchmarkReport report;             // every frame of a headless run
+int headlessFrames = 0;             // frames to render without window, 0 to open GLUT window
+bool reportFrames = false;          // add frames to report, false during warm-up
+std::string reportFile = REPORT_FILE;
+std::string csvFile;                // summary row of headless run is appended if set
+std::string captureFile;            // GL calls are written to it if set, see GlCapture.h
+int captureFrames = CAPTURE_FRAMES;
+bool glDebug = false;               // debug context and GL message collector, set by --gl-debug
+GlDebugOutput debugOutput;
+FramePacer framePacer(TARGET_RATE); // paces redraws of idleCB(), not used in headless runs
+FramePacer::Mode paceMode = FramePacer::MODE_VSYNC;
+StepClock cameraClock(CAMERA_STEP); // drives camera motion independent of frame rate
+float eyeAngle = 0;                 // camera orbit angle at current step
+float prevEyeAngle = 0;             // camera orbit angle at previous step
 std::vector<float> eyePosition = { 0, g_eyeHeight, g_eyeRadius };
 
+Simulation simulation;              // owns object state, runs on its own thread
+InstanceBuffer instanceBuffer(MATRIX_FLOATS * sizeof(float));
+DirtyRanges dirtyRanges;            // records to upload from the current snapshot
+unsigned long renderedStep = 0;     // simulation step of the snapshot being drawn
+bool glslSupported;
+GLuint progId = 0;                  // ID of GLSL program drawing instanced cubes
+GLint instanceAttribs[3] = { -1, -1, -1 };  // locations of per-instance matrix rows
+GLint uniformViewMatrix = -1;       // camera matrices for instanced cubes
+GLint uniformViewProjectionMatrix = -1;
+unsigned int uploadedCameraVersion = 0; // camera version of the matrices in progId
+Camera camera;                      // view/projection computed on CPU, shared with GLSL
+CameraPath cameraPath;              // recorded flight for repeatable benchmark runs
+std::string pathFile = PATH_FILE;
+bool pathRecording = false;
+bool pathPlaying = false;
+bool exitAfterPlayback = false;     // started with --play, quit when the flight ends
+unsigned long pathSteps = 0;        // camera steps since recording started
+ParticleSystem particleSystem;      // particle state stays on GPU
+TextRenderer hud;                   // info text drawn from glyph atlas
+LabelRenderer labels;               // object IDs drawn above the objects
+bool labelsEnabled = false;
+std::vector<float> labelX, labelY, labelZ;  // object positions in SoA for culling labels
+std::vector<int> labelIndices;      // objects selected for labels
+bool particlesEnabled = false;
+bool trackballCamera = false;       // true after the first drag, orbit camera until then
+float trackballQuat[4] = { 0, 0, 0, 1 };    // accumulated trackball rotation
+float trackballMatrix[4][4];        // rebuilt from trackballQuat once per frame when changed
+bool mouseMoved = false;            // motion events not applied yet
+int motionEvents = 0;               // motion events received since last applied
+int lastMotionEvents = 0;           // motion events coalesced into the last update
+float pendingMouseX, pendingMouseY; // latest mouse position not applied yet
+
+
+// GLSL for instanced cubes ===================================================
+// It reproduces the fixed-function directional light (GL_LIGHT0) with
+// GL_COLOR_MATERIAL, so the cubes look the same as non-instanced drawing.
+const char* vsSource = R"(
+#version 120
+attribute vec4 instanceRow0;        // rows of 3x4 instance matrix
+attribute vec4 instanceRow1;
+attribute vec4 instanceRow2;
+uniform mat4 viewMatrix;
+uniform mat4 viewProjectionMatrix;
+void main()
+{
+    vec4 v = vec4(gl_Vertex.xyz, 1.0);
+    vec4 vertex = vec4(dot(instanceRow0, v), dot(instanceRow1, v), dot(instanceRow2, v), 1.0);
+    vec3 n = vec3(dot(instanceRow0.xyz, gl_Normal), dot(instanceRow1.xyz, gl_Normal), dot(instanceRow2.xyz, gl_Normal));
+    vec3 normal = normalize(mat3(viewMatrix) * n);  // view has no scale
+    vec3 light = normalize(gl_LightSource[0].position.xyz);
+    float dotNL = max(dot(normal, light), 0.0);
+    gl_FrontColor = gl_Color * (gl_LightSource[0].ambient + gl_LightSource[0].diffuse * dotNL);
+    gl_Position = viewProjectionMatrix * vertex;
+}
+)";
+
+const char* fsSource = R"(
+#version 120
+void main()
+{
+    gl_FragColor = gl_Color;
+}
+)";
+
 
 
 // unit cube //////////////////////////////////////////////////////////////////
@@ -202,10 +361,104 @@ GLuint indices[] = {
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
+    Profiler::setThreadName("main");
     initSharedMem();
 
-    // init GLUT and GL
-    initGLUT(argc, argv);
+    // --play <file> replays a recorded camera path once and exits
+    // --headless [frames] renders into an FBO without window, --report <file> names the JSON output
+    // and --csv <file> appends a summary row; --objects <n> and --draw <method> set up the scene
+    // --capture <file> [frames] writes the GL calls of setup and the first frames for glreplay
+    // --gl-debug creates a debug context and collects the messages of the driver
+    // --pace <unlimited|target|vsync|adaptive> [fps] sets how the window redraws
+    // --validate-buffers checks the size of new buffer objects at the end of each frame
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg == "--play")
+        {
+            if(i + 1 < argc)
+                pathFile = argv[++i];
+            exitAfterPlayback = true;
+        }
+        else if(arg == "--headless")
+        {
+            headlessFrames = HEADLESS_FRAMES;
+            if(i + 1 < argc && atoi(argv[i + 1]) > 0)
+                headlessFrames = atoi(argv[++i]);
+        }
+        else if(arg == "--report")
+        {
+            if(i + 1 < argc)
+                reportFile = argv[++i];
+        }
+        else if(arg == "--csv")
+        {
+            if(i + 1 < argc)
+                csvFile = argv[++i];
+        }
+        else if(arg == "--capture")
+        {
+            if(i + 1 < argc)
+                captureFile = argv[++i];
+            if(i + 1 < argc && atoi(argv[i + 1]) > 0)
+                captureFrames = atoi(argv[++i]);
+        }
+        else if(arg == "--pace")
+        {
+            if(i + 1 < argc)
+            {
+                std::string name = argv[++i];
+                for(int j = 0; j < FramePacer::MODE_COUNT; ++j)
+                {
+                    if(name == FramePacer::getModeName((FramePacer::Mode)j))
+                        paceMode = (FramePacer::Mode)j;
+                }
+            }
+            if(i + 1 < argc && atof(argv[i + 1]) > 0)
+                framePacer.setTargetRate(atof(argv[++i]));
+        }
+        else if(arg == "--gl-debug")
+        {
+            glDebug = true;
+        }
+        else if(arg == "--validate-buffers")
+        {
+            BufferRegistry::setValidation(true);
+        }
+        else if(arg == "--objects")
+        {
+            if(i + 1 < argc && atoi(argv[i + 1]) > 0)
+                objectCount = atoi(argv[++i]);
+        }
+        else if(arg == "--draw")
+        {
+            if(i + 1 < argc)
+            {
+                std::string name = argv[++i];
+                for(int j = 0; j < DRAW_METHOD_COUNT; ++j)
+                {
+                    if(name == DRAW_METHOD_NAMES[j])
+                        drawMethod = (DrawMethod)j;
+                }
+            }
+        }
+    }
+
+    // init GLUT and GL, or a context without window for benchmark runs
+    if(headlessFrames > 0)
+    {
+        if(!headlessContext.create(screenWidth, screenHeight, glDebug))
+            return 1;
+    }
+    else
+    {
+        initGLUT(argc, argv);
+        framePacer.setMode(paceMode);   // swap interval needs the window
+    }
+    if(!captureFile.empty())
+        GlCapture::start(captureFile, captureFrames, screenWidth, screenHeight);
+    if(glDebug)
+        debugOutput.init();             // before initGL(), to get shader compiler messages
     initGL();
 
     // register exit callback
@@ -221,17 +474,13 @@ int main(int argc, char **argv)
         // glBufferData with NULL pointer reserves only memory space.
         // Copy actual data with multiple calls of glBufferSubData for vertex positions, normals, colours, etc.
         // target flag is GL_ARRAY_BUFFER, and usage flag is GL_STATIC_DRAW
-        glGenBuffers(1, &vboId);
-        glBindBuffer(GL_ARRAY_BUFFER, vboId);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices)+sizeof(normals)+sizeof(colors), 0, GL_DYNAMIC_DRAW);
+        vboId = createVBO(0, sizeof(vertices)+sizeof(normals)+sizeof(colors), GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW, "cube vertices");
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);                             // copy vertices starting from 0 offest
         glBufferSubData(GL_ARRAY_BUFFER, sizeof(vertices), sizeof(normals), normals);                // copy normals after vertices
         glBufferSubData(GL_ARRAY_BUFFER, sizeof(vertices)+sizeof(normals), sizeof(colors), colors);  // copy colours after normals
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        glGenBuffers(1, &iboId);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+        iboId = createVBO(indices, sizeof(indices), GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW, "cube indices");
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
         std::cout << "Video card supports GL_ARB_vertex_buffer_object." << std::endl;
@@ -241,9 +490,78 @@ int main(int argc, char **argv)
         std::cout << "[WARNING] Video card does NOT support GL_ARB_vertex_buffer_object." << std::endl;
     }
 
+    // info text is drawn from a font texture in one batch
+    hud.init();
+
+    // GPU time of each pass comes back from timer queries a few frames later
+    if(ext.isSupported("GL_ARB_timer_query"))
+        gpuTimer.init(GPU_PASS_COUNT);
+
+    // instanced drawing needs GLSL, per-instance attributes and GPU-side buffer copy
+    glslSupported = vboSupported &&
+                    ext.isSupported("GL_ARB_vertex_shader") &&
+                    ext.isSupported("GL_ARB_instanced_arrays") &&
+                    ext.isSupported("GL_ARB_copy_buffer");
+    if(glslSupported)
+        glslSupported = initGLSL();
+    if(glslSupported)
+    {
+        // local bounding box of the cube for collision
+        float boundsMin[3] = { vertices[0], vertices[1], vertices[2] };
+        float boundsMax[3] = { vertices[0], vertices[1], vertices[2] };
+        for(int i = 0; i < (int)(sizeof(vertices) / sizeof(vertices[0])); ++i)
+        {
+            boundsMin[i % 3] = std::min(boundsMin[i % 3], vertices[i]);
+            boundsMax[i % 3] = std::max(boundsMax[i % 3], vertices[i]);
+        }
+        simulation.setObjectBounds(boundsMin, boundsMax);
+
+        int gridSize = (int)ceil(sqrt((double)objectCount));
+        instanceBuffer.init(objectCount);
+        simulation.setManual(headlessFrames > 0 || exitAfterPlayback);     // stepped per frame, see displayCB()
+        simulation.start(gridSize, GRID_SPACING, scale, objectCount);
+        std::cout << "Drawing " << objectCount << " objects (" << DRAW_METHOD_NAMES[drawMethod] << ")." << std::endl;
+    }
+    else
+    {
+        std::cout << "[WARNING] Instanced drawing is NOT supported, drawing a single cube." << std::endl;
+    }
+
+    // particles are integrated on GPU with transform feedback
+    if(glslSupported && ext.isSupported("GL_EXT_transform_feedback"))
+    {
+        if(particleSystem.init(PARTICLE_COUNT))
+            std::cout << "Particle system is ready with " << PARTICLE_COUNT << " particles." << std::endl;
+    }
+    else
+    {
+        std::cout << "[WARNING] Video card does NOT support GL_EXT_transform_feedback, no particles." << std::endl;
+    }
+
+    // object labels are instanced glyphs from the same font atlas as info text
+    if(glslSupported && labels.init(hud))
+    {
+        labels.setGlyphHeight(LABEL_HEIGHT);
+        labels.setFadeDistance(LABEL_FADE_START, LABEL_FADE_END);
+        labels.setMaxLabels(MAX_LABELS);
+    }
+
+    // the calls so far are replayed once, the frames after are timed
+    GlCapture::endSetup();
+
     // the last GLUT call (LOOP)
     // window will be shown and display callback is triggered by events
     // NOTE: this call never return main().
+    if(exitAfterPlayback)
+    {
+        startPlayback();
+        if(!pathPlaying)
+            return 1;
+    }
+
+    if(headlessFrames > 0)
+        return runHeadless() ? 0 : 1;
+
     glutMainLoop(); /* Start GLUT event-processing loop */
 
     return 0;
@@ -261,6 +579,11 @@ int initGLUT(int argc, char **argv)
 
     glutInitDisplayMode(GLUT_RGBA | GLUT_DOUBLE | GLUT_DEPTH | GLUT_STENCIL);   // display mode
 
+#ifdef GLUT_DEBUG
+    if(glDebug)
+        glutInitContextFlags(GLUT_DEBUG);           // freeglut only
+#endif
+
     glutInitWindowSize(screenWidth, screenHeight);  // window size
 
     glutInitWindowPosition(100, 100);               // window location
@@ -323,54 +646,117 @@ void initGL()
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// write 2d text using GLUT
-// The projection matrix must be set to orthogonal before call this function.
+// create GLSL program for instanced cubes
 ///////////////////////////////////////////////////////////////////////////////
-void drawString(const char *str, int x, int y, float color[4], void *font)
+bool initGLSL()
 {
-    glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT); // lighting and color mask
-    glDisable(GL_LIGHTING);     // need to disable lighting for proper text color
-    glDisable(GL_TEXTURE_2D);
+    progId = createShaderProgram(vsSource, fsSource);
+    if(!progId)
+        return false;
+
+    instanceAttribs[0] = glGetAttribLocation(progId, "instanceRow0");
+    instanceAttribs[1] = glGetAttribLocation(progId, "instanceRow1");
+    instanceAttribs[2] = glGetAttribLocation(progId, "instanceRow2");
+    uniformViewMatrix = glGetUniformLocation(progId, "viewMatrix");
+    uniformViewProjectionMatrix = glGetUniformLocation(progId, "viewProjectionMatrix");
+    uploadedCameraVersion = 0;
+    return instanceAttribs[0] >= 0 && instanceAttribs[1] >= 0 && instanceAttribs[2] >= 0;
+}
+
 
-    glColor4fv(color);          // set text color
-    glRasterPos2i(x, y);        // place text position
 
-    // loop all characters in the string
-    while(*str)
+///////////////////////////////////////////////////////////////////////////////
+// bring the instance buffer up to date with a new snapshot taken by displayCB()
+// The structural changes are replayed in order (GPU-side moves for removed
+// objects), then only the dirty records are converted to instance matrices
+// by InstanceBuffer::upload().
+///////////////////////////////////////////////////////////////////////////////
+void updateInstances()
+{
+    PROFILE_FUNCTION();
+    const SimSnapshot& snapshot = simulation.getSnapshot();
+    int count = (int)snapshot.instances.size();
+
+    if(!snapshot.full)
     {
-        glutBitmapCharacter(font, *str);
-        ++str;
+        for(size_t i = 0; i < snapshot.ops.size(); ++i)
+        {
+            // skip the changes already replayed from the previous snapshot
+            const InstanceOp& op = snapshot.ops[i];
+            if(op.step <= renderedStep)
+                continue;
+
+            if(op.type == InstanceOp::ADD)
+            {
+                // out of GPU memory: the indices of later removes would be wrong,
+                // so stop here and let the replacement below fit what it can
+                if(!instanceBuffer.resize(instanceBuffer.getCount() + op.value))
+                    break;
+            }
+            else
+            {
+                instanceBuffer.remove(op.value);
+            }
+        }
+
+        const std::vector<DirtyRanges::Range>& ranges = snapshot.dirty.getRanges();
+        for(size_t i = 0; i < ranges.size(); ++i)
+            dirtyRanges.add(ranges[i].first, ranges[i].count);
     }
 
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_LIGHTING);
-    glPopAttrib();
+    // replace everything if changes were not tracked or replay went wrong
+    // If the storage cannot grow, the buffer keeps fewer records than the
+    // snapshot; upload() and the draw call use the buffer count, so only the
+    // objects that fit are drawn.
+    if(snapshot.full || instanceBuffer.getCount() != count)
+    {
+        instanceBuffer.resize(count);
+        dirtyRanges.clear();
+        dirtyRanges.add(0, count);
+    }
+
+    if(count > 0)
+        instanceBuffer.upload(dirtyRanges, writeInstanceMatrices, &snapshot.instances[0]);
+    else
+        dirtyRanges.clear();
+
+    renderedStep = snapshot.step;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// draw a string in 3D space
+// InstanceBuffer::WriteFunc converting simulation records to 3x4 matrices
+// The records are gathered into small SoA arrays that stay in L1 cache, then
+// converted by batchQuatToMatrix() with SIMD.
 ///////////////////////////////////////////////////////////////////////////////
-void drawString3D(const char *str, float pos[3], float color[4], void *font)
+void writeInstanceMatrices(void* dst, int first, int count, const void* userData)
 {
-    glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT); // lighting and color mask
-    glDisable(GL_LIGHTING);     // need to disable lighting for proper text color
-    glDisable(GL_TEXTURE_2D);
+    const Instance* instances = (const Instance*)userData + first;
+    float* matrices = (float*)dst;
 
-    glColor4fv(color);          // set text color
-    glRasterPos3fv(pos);        // place text position
+    float x[CONVERT_BATCH], y[CONVERT_BATCH], z[CONVERT_BATCH], s[CONVERT_BATCH];
+    float qx[CONVERT_BATCH], qy[CONVERT_BATCH], qz[CONVERT_BATCH], qw[CONVERT_BATCH];
+    Vec3SoA positions(x, y, z);
+    QuatSoA orientations(qx, qy, qz, qw);
 
-    // loop all characters in the string
-    while(*str)
+    for(int i = 0; i < count; i += CONVERT_BATCH)
     {
-        glutBitmapCharacter(font, *str);
-        ++str;
+        int n = std::min(CONVERT_BATCH, count - i);
+        for(int j = 0; j < n; ++j)
+        {
+            const Instance& inst = instances[i + j];
+            x[j] = inst.x;
+            y[j] = inst.y;
+            z[j] = inst.z;
+            s[j] = inst.scale;
+            qx[j] = inst.qx;
+            qy[j] = inst.qy;
+            qz[j] = inst.qz;
+            qw[j] = inst.qw;
+        }
+        batchQuatToMatrix(orientations, positions, s, matrices + i * MATRIX_FLOATS, n);
     }
-
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_LIGHTING);
-    glPopAttrib();
 }
 
 
@@ -389,6 +775,16 @@ bool initSharedMem()
     cameraAngleX = cameraAngleY = 0.0f;
     cameraDistance = CAMERA_DISTANCE;
 
+    build_rotmatrix(trackballMatrix, trackballQuat);
+
+    phaseUpdate  = frameStats.addPhase("update");
+    phaseScene   = frameStats.addPhase("scene");
+    phaseEffects = frameStats.addPhase("effects");
+    phaseHud     = frameStats.addPhase("hud");
+    phaseSwap    = frameStats.addPhase("swap");
+    for(int i = 0; i < GPU_PASS_COUNT; ++i)
+        frameStats.addGpuPass(GPU_PASS_NAMES[i]);
+
     drawMode = 0; // 0:fill, 1: wireframe, 2:points
 
     return true;
@@ -408,6 +804,19 @@ void clearSharedMem()
         deleteVBO(iboId);
         vboId = iboId = 0;
     }
+
+    if(glslSupported)
+    {
+        simulation.stop();
+        instanceBuffer.release();
+        deleteShaderProgram(progId);
+        progId = 0;
+    }
+
+    particleSystem.release();
+    gpuTimer.release();
+    labels.release();
+    hud.release();
 }
 
 
@@ -439,55 +848,204 @@ void initLights()
 ///////////////////////////////////////////////////////////////////////////////
 void setCamera(float posX, float posY, float posZ, float targetX, float targetY, float targetZ)
 {
+    camera.lookAt(Vec3(posX, posY, posZ), Vec3(targetX, targetY, targetZ)); // eye(x,y,z), focal(x,y,z)
     glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    gluLookAt(posX, posY, posZ, targetX, targetY, targetZ, 0, 1, 0); // eye(x,y,z), focal(x,y,z), up(x,y,z)
+    glLoadMatrixf(camera.getViewMatrix().get());
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// generate vertex buffer object and bind it with its data
-// You must give 2 hints about data usage; target and mode, so that OpenGL can
-// decide which data should be stored and its location.
-// VBO works with 2 different targets; GL_ARRAY_BUFFER for vertex arrays
-// and GL_ELEMENT_ARRAY_BUFFER for index array in glDrawElements().
-// The default target is GL_ARRAY_BUFFER.
-// By default, usage mode is set as GL_STATIC_DRAW.
-// Other usages are GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY,
-// GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY,
-// GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY.
+// apply the mouse motion accumulated since the last call to trackball camera
+// Left drag rotates with the virtual trackball, right drag zooms. The motion
+// events are coalesced into one trackball() step from the last applied
+// position to the latest one, so the matrix is rebuilt at most once a frame.
 ///////////////////////////////////////////////////////////////////////////////
-GLuint createVBO(const void* data, int dataSize, GLenum target, GLenum usage)
+void updateTrackball()
 {
-    GLuint id = 0;  // 0 is reserved, glGenBuffersARB() will return non-zero id if success
+    if(!mouseMoved)
+        return;
+
+    if(mouseLeftDown)
+    {
+        // window coords to (-1, 1), y up
+        float q[4];
+        trackball(q, (2.0f * mouseX - screenWidth) / screenWidth, (screenHeight - 2.0f * mouseY) / screenHeight,
+                  (2.0f * pendingMouseX - screenWidth) / screenWidth, (screenHeight - 2.0f * pendingMouseY) / screenHeight);
+        add_quats(q, trackballQuat, trackballQuat);
+        build_rotmatrix(trackballMatrix, trackballQuat);
+    }
+    if(mouseRightDown)
+    {
+        cameraDistance -= (pendingMouseY - mouseY) * 0.2f;
+        if(cameraDistance < 1.0f)
+            cameraDistance = 1.0f;
+    }
+
+    mouseX = pendingMouseX;
+    mouseY = pendingMouseY;
+    lastMotionEvents = motionEvents;
+    motionEvents = 0;
+    mouseMoved = false;
+}
+
 
-    glGenBuffers(1, &id);                           // create a vbo
-    glBindBuffer(target, id);                       // activate vbo id to use
-    glBufferData(target, dataSize, data, usage);    // upload data to video card
 
-    // check data size in VBO is same as input array, if not return 0 and delete VBO
-    int bufferSize = 0;
-    glGetBufferParameteriv(target, GL_BUFFER_SIZE, &bufferSize);
-    if(dataSize != bufferSize)
+///////////////////////////////////////////////////////////////////////////////
+// add the current camera to the recorded path
+// The target is put in front of the eye at the distance to the origin, which
+// is where both the orbit and the trackball camera look at.
+///////////////////////////////////////////////////////////////////////////////
+void recordCameraKey(float time)
+{
+    const Mat4& view = camera.getViewMatrix();
+    Vec3 eye = camera.getPosition();
+    Vec3 up(view.at(1, 0), view.at(1, 1), view.at(1, 2));
+    Vec3 forward(-view.at(2, 0), -view.at(2, 1), -view.at(2, 2));
+    cameraPath.addKey(time, eye, eye + forward * length(eye), up);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start/stop recording the camera path flown by the user
+///////////////////////////////////////////////////////////////////////////////
+void startRecording()
+{
+    cameraPath.clear();
+    pathSteps = 0;
+    recordCameraKey(0);
+    pathRecording = true;
+    std::cout << "Recording camera path to " << pathFile << "." << std::endl;
+}
+
+void stopRecording()
+{
+    pathRecording = false;
+    if(pathSteps % PATH_KEY_STEPS != 0)
+        recordCameraKey((float)(pathSteps * CAMERA_STEP));
+
+    if(cameraPath.getKeyCount() < 2)
+        std::cout << "[WARNING] Camera path is too short, not saved." << std::endl;
+    else if(cameraPath.save(pathFile))
+        std::cout << "Saved " << cameraPath.getKeyCount() << " keyframes (" << cameraPath.getDuration()
+                  << " s) to " << pathFile << "." << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// replay the recorded camera path from file
+// The camera clock is switched to manual and fed one step per frame, so the
+// same frames are rendered at any frame rate. The frame time statistics of
+// each segment are printed at the end of flight.
+///////////////////////////////////////////////////////////////////////////////
+void startPlayback()
+{
+    if(!cameraPath.load(pathFile))
+        return;
+
+    cameraClock.reset();
+    cameraClock.setManual(true);
+    cameraPath.beginPlayback();
+    pathPlaying = true;
+    std::cout << "Playing camera path " << pathFile << " (" << cameraPath.getKeyCount() << " keyframes, "
+              << cameraPath.getDuration() << " s)." << std::endl;
+}
+
+void stopPlayback()
+{
+    pathPlaying = false;
+    cameraClock.setManual(false);
+    cameraPath.printStats(std::cout);
+
+    // a headless run writes its report before exit
+    if(exitAfterPlayback && headlessFrames == 0)
+        exit(0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw every object of the latest snapshot with its own glDrawElements()
+// The matrices are computed the same way as for instancing and loaded with
+// glMultMatrixf(), so both methods draw the same scene. The vertex and index
+// arrays must be bound already, and displayCB() takes the snapshot.
+///////////////////////////////////////////////////////////////////////////////
+void drawObjects()
+{
+    PROFILE_FUNCTION();
+    const SimSnapshot& snapshot = simulation.getSnapshot();
+    int count = (int)snapshot.instances.size();
+    if(count == 0)
+        return;
+
+    float rows[CONVERT_BATCH * MATRIX_FLOATS];
+    float matrix[16];
+    for(int i = 0; i < count; i += CONVERT_BATCH)
     {
-        glDeleteBuffers(1, &id);
-        id = 0;
-        std::cout << "[createVBO()] Data size is mismatch with input array\n";
+        int n = std::min(CONVERT_BATCH, count - i);
+        writeInstanceMatrices(rows, i, n, &snapshot.instances[0]);
+        for(int j = 0; j < n; ++j)
+        {
+            // 3x4 rows to column-major 4x4
+            const float* r = rows + j * MATRIX_FLOATS;
+            matrix[0] = r[0];  matrix[4] = r[1];  matrix[8]  = r[2];   matrix[12] = r[3];
+            matrix[1] = r[4];  matrix[5] = r[5];  matrix[9]  = r[6];   matrix[13] = r[7];
+            matrix[2] = r[8];  matrix[6] = r[9];  matrix[10] = r[10];  matrix[14] = r[11];
+            matrix[3] = 0;     matrix[7] = 0;     matrix[11] = 0;      matrix[15] = 1;
+
+            glPushMatrix();
+            glMultMatrixf(matrix);
+            glDrawElements(GL_TRIANGLES, 72, GL_UNSIGNED_INT, (void*)0);
+            glPopMatrix();
+        }
     }
 
-    return id;      // return VBO id
+    renderedStep = snapshot.step;
+    frameDrawCalls += count;
+    frameTriangles += 24LL * count;
+    frameUploadBytes += (long long)count * sizeof(matrix);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// destroy a VBO
-// If VBO id is not valid or zero, then OpenGL ignores it silently.
+// label the objects near the camera with their index
+// Only the positions are gathered for all objects; the text is formatted for
+// the labels left after culling.
 ///////////////////////////////////////////////////////////////////////////////
-void deleteVBO(GLuint vboId)
+void drawLabels()
 {
-    glDeleteBuffers(1, &vboId);
+    PROFILE_FUNCTION();
+    const SimSnapshot& snapshot = simulation.getSnapshot();
+    int count = (int)snapshot.instances.size();
+    labelX.resize(count);
+    labelY.resize(count);
+    labelZ.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        const Instance& inst = snapshot.instances[i];
+        labelX[i] = inst.x;
+        labelY[i] = inst.y + inst.scale * 1.5f;     // above the cube
+        labelZ[i] = inst.z;
+    }
+
+    labels.begin(camera);
+    if(count > 0)
+        labels.select(Vec3SoA(&labelX[0], &labelY[0], &labelZ[0]), count, LABEL_HEIGHT * 4, labelIndices);
+    else
+        labelIndices.clear();                       // indices of the last frame point past the positions
+
+    float color[4] = {1, 1, 0.6f, 1};
+    char text[16];
+    for(size_t i = 0; i < labelIndices.size(); ++i)
+    {
+        int id = labelIndices[i];
+        snprintf(text, sizeof(text), "#%d", id);
+        labels.addLabel(Vec3(labelX[id], labelY[id], labelZ[id]), text, color);
+    }
+    labels.draw();
 }
 
 
@@ -497,30 +1055,295 @@ void deleteVBO(GLuint vboId)
 ///////////////////////////////////////////////////////////////////////////////
 void showInfo()
 {
-    // backup current model-view matrix
-    glPushMatrix();                     // save current modelview matrix
-    glLoadIdentity();                   // reset modelview matrix
+    PROFILE_FUNCTION();
+    float color[4] = {1, 1, 1, 1};
 
-    // set to 2D orthogonal projection
-    glMatrixMode(GL_PROJECTION);     // switch to projection matrix
-    glPushMatrix();                  // save current projection matrix
-    glLoadIdentity();                // reset projection matrix
-    gluOrtho2D(0, screenWidth, 0, screenHeight);  // set to orthogonal projection
+    const FrameStats::Summary& frame = frameStats.getSummary(FrameStats::FRAME);
+    const FrameStats::Summary& cpu = frameStats.getSummary(FrameStats::CPU);
+    const FrameStats::Summary& gpu = frameStats.getSummary(FrameStats::GPU);
+    hud.addTextf(1, screenHeight-TEXT_HEIGHT, color, "FPS: %.1f (%.2f ms), %d spikes",
+                 frame.mean > 0 ? 1000 / frame.mean : 0.0, frame.mean, frameStats.getSpikeCount());
+    hud.addTextf(1, screenHeight-(2*TEXT_HEIGHT), color, "Frame: p50 %.2f, p95 %.2f, p99 %.2f, max %.2f ms",
+                 frame.p50, frame.p95, frame.p99, frame.max);
+    hud.addTextf(1, screenHeight-(3*TEXT_HEIGHT), color, "CPU:   p50 %.2f, p95 %.2f, p99 %.2f, max %.2f ms",
+                 cpu.p50, cpu.p95, cpu.p99, cpu.max);
+    if(gpuTimer.isInitialized())
+        hud.addTextf(1, screenHeight-(4*TEXT_HEIGHT), color, "GPU:   p50 %.2f, p95 %.2f, p99 %.2f, max %.2f ms",
+                     gpu.p50, gpu.p95, gpu.p99, gpu.max);
+    else
+        hud.addText(1, screenHeight-(4*TEXT_HEIGHT), "GPU: timer query not supported", color);
+    if(gpuTimer.isInitialized())
+    {
+        // mean of each pass, and frames skipped because their queries were still pending
+        char passes[256];
+        int length = snprintf(passes, sizeof(passes), "GPU passes:");
+        for(int i = 0; i < GPU_PASS_COUNT && length < (int)sizeof(passes); ++i)
+            length += snprintf(passes + length, sizeof(passes) - length, " %s %.2f%s", GPU_PASS_NAMES[i],
+                               frameStats.getGpuPassMean(i), i + 1 < GPU_PASS_COUNT ? "," : " ms");
+        if(length < (int)sizeof(passes))
+            snprintf(passes + length, sizeof(passes) - length, ", %d frames not timed", gpuTimer.getDroppedFrames());
+        hud.addText(1, screenHeight-(5*TEXT_HEIGHT), passes, color);
+    }
+    drawFrameGraph(screenWidth - GRAPH_WIDTH - 4, screenHeight - GRAPH_HEIGHT - 4);
 
-    float color[4] = {1, 1, 1, 1};
+    if(glslSupported)
+    {
+        if(drawMethod == DRAW_INSTANCED)
+            hud.addTextf(1, screenHeight-(6*TEXT_HEIGHT), color, "Objects: %d / %d, instanced",
+                         instanceBuffer.getCount(), instanceBuffer.getCapacity());
+        else
+            hud.addTextf(1, screenHeight-(6*TEXT_HEIGHT), color, "Objects: %d, one draw call each",
+                         (int)simulation.getSnapshot().instances.size());
+
+        hud.addTextf(1, screenHeight-(7*TEXT_HEIGHT), color, "GPU Copy: %d bytes/frame", instanceBuffer.getBytesCopied());
+
+        hud.addTextf(1, screenHeight-(8*TEXT_HEIGHT), color, "Upload: %d bytes/frame in %d ranges (gap %d)",
+                     instanceBuffer.getBytesUploaded(), instanceBuffer.getUploadCalls(), dirtyRanges.getGapThreshold());
+
+        hud.addTextf(1, screenHeight-(9*TEXT_HEIGHT), color, "Moving: %d objects",
+                     updatePositions ? simulation.getMovingCount() : 0);
+
+        hud.addTextf(1, screenHeight-(10*TEXT_HEIGHT), color, "Simulation: step %lu, drawing step %lu",
+                     simulation.getStepCount(), renderedStep);
+
+        if(simulation.isCollision())
+            hud.addTextf(1, screenHeight-(11*TEXT_HEIGHT), color, "Collision: %d pairs, broadphase %.2f ms (axis %c, %d threads)",
+                         simulation.getPairCount(), simulation.getBroadphaseTime(),
+                         "XYZ"[simulation.getBroadphaseAxis()], simulation.getBroadphaseThreads());
+        else
+            hud.addText(1, screenHeight-(11*TEXT_HEIGHT), "Collision: off", color);
+
+        if(!particleSystem.isInitialized())
+            hud.addText(1, screenHeight-(12*TEXT_HEIGHT), "Particles: not supported", color);
+        else if(particlesEnabled)
+            hud.addTextf(1, screenHeight-(12*TEXT_HEIGHT), color, "Particles: %d (transform feedback)", particleSystem.getCount());
+        else
+            hud.addText(1, screenHeight-(12*TEXT_HEIGHT), "Particles: off", color);
+
+        if(pathPlaying)
+            hud.addTextf(1, screenHeight-(13*TEXT_HEIGHT), color, "Camera: playing %s, segment %d / %d", pathFile.c_str(),
+                         cameraPath.getSegment((float)cameraClock.getTime()) + 1, cameraPath.getKeyCount() - 1);
+        else if(pathRecording)
+            hud.addTextf(1, screenHeight-(13*TEXT_HEIGHT), color, "Camera: recording %d keys to %s",
+                         cameraPath.getKeyCount(), pathFile.c_str());
+        else if(trackballCamera)
+            hud.addTextf(1, screenHeight-(13*TEXT_HEIGHT), color, "Camera: trackball, %d motion events in last update", lastMotionEvents);
+        else
+            hud.addText(1, screenHeight-(13*TEXT_HEIGHT), "Camera: orbit", color);
+
+        if(!labels.isInitialized())
+            hud.addText(1, screenHeight-(14*TEXT_HEIGHT), "Labels: not supported", color);
+        else if(labelsEnabled)
+            hud.addTextf(1, screenHeight-(14*TEXT_HEIGHT), color, "Labels: %d of %d objects, %d glyphs in 1 draw",
+                         labels.getLabelCount(), labels.getCandidateCount(), labels.getGlyphCount());
+        else
+            hud.addText(1, screenHeight-(14*TEXT_HEIGHT), "Labels: off", color);
+
+        hud.addText(1, 1+TEXT_HEIGHT, "Drag left/right mouse to rotate/zoom, o to orbit, r record path, f fly path, t save trace, v pacing.", color);
+        hud.addTextf(1, 1, color, "Press +/- to add/remove %d objects, [/] moving objects, g/G gap, c collision, p particles, l labels.", OBJECT_STEP);
+    }
 
-    std::stringstream ss;
-    ss << "FPS: " << fps << std::ends;  // add 0(ends) at the end
-    drawString(ss.str().c_str(), 1, screenHeight-TEXT_HEIGHT, color, font);
-    ss.str(""); // clear buffer
+    if(GlCallCounter::isEnabled())
+    {
+        // GL calls of the last frame, entry points called most often first
+        hud.addTextf(1, screenHeight-(15*TEXT_HEIGHT), color, "GL calls: %d, binds %d (%d redundant), state changes %d (%d redundant)",
+                     GlCallCounter::getCalls(), GlCallCounter::getBinds(), GlCallCounter::getRedundantBinds(),
+                     GlCallCounter::getStateChanges(), GlCallCounter::getRedundantStateChanges());
+
+        GlCallCounter::Entry top[5];
+        int topCount = GlCallCounter::getTopEntries(top, 5);
+        char line[256];
+        int length = snprintf(line, sizeof(line), "Top:");
+        for(int i = 0; i < topCount && length < (int)sizeof(line); ++i)
+        {
+            if(top[i].redundant > 0)
+                length += snprintf(line + length, sizeof(line) - length, " %s %d (%d redundant)%s", top[i].name,
+                                   top[i].calls, top[i].redundant, i + 1 < topCount ? "," : "");
+            else
+                length += snprintf(line + length, sizeof(line) - length, " %s %d%s", top[i].name, top[i].calls,
+                                   i + 1 < topCount ? "," : "");
+        }
+        hud.addText(1, screenHeight-(16*TEXT_HEIGHT), line, color);
+    }
 
+    if(headlessFrames == 0)
+    {
+        // above the help text; the rate is lower than the target while adaptive pacing drops frames
+        hud.addTextf(1, 1+2*TEXT_HEIGHT, color, "Pacing: %s %.0f fps, %d missed, %d idle frames skipped, spin %.2f ms",
+                     FramePacer::getModeName(framePacer.getMode()), framePacer.getRate(), framePacer.getMissedFrames(),
+                     framePacer.getSkippedFrames(), framePacer.getSpinMargin());
+    }
+
+    // buffer objects of createVBO(), above the pacing line; the peak RSS is the CPU side
+    hud.addTextf(1, 1+3*TEXT_HEIGHT, color, "Buffers: %d live, %.2f MB (peak %d, %.2f MB), process peak RSS %.1f MB",
+                 BufferRegistry::getLiveCount(), BufferRegistry::getLiveBytes() / (1024.0 * 1024.0),
+                 BufferRegistry::getPeakCount(), BufferRegistry::getPeakBytes() / (1024.0 * 1024.0),
+                 getPeakRss() / 1024.0);
 
-    // restore projection matrix
-    glPopMatrix();                   // restore to previous projection matrix
+    if(debugOutput.isInitialized())
+    {
+        // messages of the driver in the last frame, below the GL call counts if shown
+        int row = GlCallCounter::isEnabled() ? 17 : 15;
+        hud.addTextf(1, screenHeight-(row*TEXT_HEIGHT), color, "GL debug: %d messages (%d performance, %d errors), %d unique%s",
+                     debugOutput.getFrameCount(), debugOutput.getFrameCount(GlDebugOutput::KIND_PERFORMANCE),
+                     debugOutput.getFrameCount(GlDebugOutput::KIND_ERROR), debugOutput.getUniqueCount(),
+                     debugOutput.isDebugContext() ? "" : ", not a debug context");
+
+        const GlDebugOutput::Message* perf = debugOutput.getLastPerformance();
+        if(perf)
+            hud.addTextf(1, screenHeight-((row+1)*TEXT_HEIGHT), color, "Last performance: %.100s", perf->text.c_str());
+    }
 
-    // restore modelview matrix
-    glMatrixMode(GL_MODELVIEW);      // switch to modelview matrix
-    glPopMatrix();                   // restore to previous modelview matrix
+    // all lines above in one draw call
+    hud.draw(screenWidth, screenHeight);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw the times of recent frames as bars, newest on the right
+// The bar color shows whether the frame fit in the budget of 60 Hz, and the
+// blue mark on a bar is the GPU time of that frame if known.
+///////////////////////////////////////////////////////////////////////////////
+void drawFrameGraph(int x, int y)
+{
+    const float background[4] = {0, 0, 0, 0.5f};
+    const float green[4] = {0.2f, 0.9f, 0.2f, 0.8f};
+    const float yellow[4] = {0.9f, 0.9f, 0.2f, 0.8f};
+    const float red[4] = {1.0f, 0.2f, 0.2f, 0.9f};
+    const float blue[4] = {0.3f, 0.6f, 1.0f, 1.0f};
+    const float line[4] = {1, 1, 1, 0.5f};
+
+    hud.addRect((float)x, (float)y, (float)GRAPH_WIDTH, (float)GRAPH_HEIGHT, background);
+
+    int count = std::min(frameStats.getCount(), GRAPH_WIDTH);
+    for(int i = 0; i < count; ++i)
+    {
+        const FrameStats::Frame& f = frameStats.getFrame(i);
+        float ms = f.frameNs * 1e-6f;
+        const float* color = ms <= FRAME_BUDGET ? green : (ms <= 2 * FRAME_BUDGET ? yellow : red);
+        float barX = (float)(x + GRAPH_WIDTH - 1 - i);
+        hud.addRect(barX, (float)y, 1, std::min(ms * GRAPH_SCALE, (float)GRAPH_HEIGHT), color);
+
+        if(f.gpuNs >= 0)
+            hud.addRect(barX, y + std::min(f.gpuNs * 1e-6f * GRAPH_SCALE, (float)GRAPH_HEIGHT - 1), 1, 1, blue);
+    }
+
+    // budget line
+    hud.addRect((float)x, y + FRAME_BUDGET * GRAPH_SCALE, (float)GRAPH_WIDTH, 1, line);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pass GPU times of previous frames that are ready to the statistics
+// It never waits; frames whose queries are pending are collected later.
+///////////////////////////////////////////////////////////////////////////////
+void collectGpuTimes()
+{
+    PROFILE_FUNCTION();
+    unsigned long frame;
+    long long times[GPU_PASS_COUNT];
+    while(gpuTimer.poll(frame, times))
+    {
+        frameStats.setGpuTimes(frame, times);
+        if(reportFrames)
+            report.setGpuTimes(frame, times);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// true if the next frame would look the same as the last one: the trackball
+// camera is still, nothing moves or is recorded, and the simulation has no
+// snapshot which is not drawn yet (e.g. objects added after the last frame)
+// The orbit camera turns every frame, so the scene is never idle with it.
+///////////////////////////////////////////////////////////////////////////////
+bool isSceneIdle()
+{
+    bool objectsMove = glslSupported && (simulation.hasNewSnapshot() ||
+                       (simulation.isAnimated() && simulation.getMovingCount() > 0));
+    bool particlesMove = particlesEnabled && particleSystem.isInitialized();
+    return trackballCamera && !mouseMoved && !pathPlaying && !pathRecording && !objectsMove && !particlesMove;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render a fixed number of frames into the FBO and write the JSON report
+// The camera and the simulation advance one fixed frame time per frame, and
+// the simulation runs on this thread (Simulation::setManual()), so the same
+// frames are drawn regardless of the speed of the machine. With --play, the
+// run ends early when the flight is over.
+// The first frames compile shaders and fill buffers in the driver; they are
+// drawn before the run and left out of the report.
+///////////////////////////////////////////////////////////////////////////////
+bool runHeadless()
+{
+    toPerspective();
+    cameraClock.setManual(true);
+
+    for(int i = 0; i < WARMUP_FRAMES; ++i)
+        displayCB();
+    glFinish();
+    collectGpuTimes();
+    reportFrames = true;
+
+    std::cout << "Rendering " << headlessFrames << " frames headless (" << headlessContext.getDescription()
+              << ", " << screenWidth << "x" << screenHeight << ")" << std::endl;
+    for(int i = 0; i < headlessFrames; ++i)
+    {
+        displayCB();
+        if(exitAfterPlayback && !pathPlaying)
+            break;
+    }
+
+    // GPU times of the last frames are ready after glFinish()
+    glFinish();
+    collectGpuTimes();
+
+    report.setInfo("renderer", (const char*)glGetString(GL_RENDERER));
+    report.setInfo("version", (const char*)glGetString(GL_VERSION));
+    report.setInfo("context", headlessContext.getDescription());
+    report.setInfo("width", screenWidth);
+    report.setInfo("height", screenHeight);
+    report.setInfo("objects", glslSupported ? (long long)simulation.getSnapshot().instances.size() : 1);
+    report.setInfo("drawMethod", DRAW_METHOD_NAMES[drawMethod]);
+    report.setInfo("peakRssKb", getPeakRss());
+    report.setInfo("peakBufferBytes", BufferRegistry::getPeakBytes());
+    report.setInfo("cameraPath", exitAfterPlayback ? pathFile : std::string("orbit"));
+    if(!report.save(reportFile))
+        return false;
+    if(!csvFile.empty())
+        report.appendCsv(csvFile, DRAW_METHOD_NAMES[drawMethod], (int)simulation.getSnapshot().instances.size(), getPeakRss());
+
+    // the frames in the JSON, not the recent frames of FrameStats which include warm-up
+    FrameStats::Summary frame = report.getFrameSummary();
+    std::cout << "Wrote " << report.getFrameCount() << " frames to " << reportFile
+              << " (mean " << frame.mean << " ms, p99 " << frame.p99 << " ms)" << std::endl;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the peak resident set size of the process in KB, 0 if unknown
+///////////////////////////////////////////////////////////////////////////////
+long getPeakRss()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return (long)(usage.ru_maxrss / 1024);          // bytes on macOS
+#else
+    return (long)usage.ru_maxrss;
+#endif
+#endif
 }
 
 
@@ -554,9 +1377,10 @@ void toPerspective()
     glViewport(0, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
 
     // set perspective viewing frustum
+    camera.setViewport(screenWidth, screenHeight);
+    camera.setPerspective(60.0f, 0.1f, 100.0f);     // FOV, NearClip, FarClip
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(60.0f, (float)(screenWidth)/screenHeight, 0.1f, 100.0f); // FOV, AspectRatio, NearClip, FarClip
+    glLoadMatrixf(camera.getProjectionMatrix().get());
 
     // switch to modelview matrix in order to set scene
     glMatrixMode(GL_MODELVIEW);
@@ -574,77 +1398,236 @@ void toPerspective()
 
 void displayCB()
 {
+    Profiler::markFrame();
+    PROFILE_FUNCTION();
+    frameStats.beginFrame();
+    frameDrawCalls = 0;
+    frameTriangles = 0;
+    frameUploadBytes = 0;
+
+    collectGpuTimes();
+    gpuTimer.beginFrame(frameStats.getFrameNumber());
+
     // clear buffer
+    gpuTimer.begin(GPU_CLEAR);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    gpuTimer.end(GPU_CLEAR);
+    gpuTimer.begin(GPU_SCENE);
 
     // save the initial ModelView matrix before modifying ModelView matrix
     glPushMatrix();
-	frames++;
 
-	eyePosition[0] = sin(frames * g_eyeSpeed) * g_eyeRadius; // x 
-	eyePosition[2] = cos(frames * g_eyeSpeed) * g_eyeRadius; // z 
+    // a replayed flight or headless run advances exactly one step per frame
+    if(pathPlaying || headlessFrames > 0)
+        cameraClock.addTime(CAMERA_STEP);
+
+    // advance camera orbit in fixed steps and interpolate between the last two
+    int steps = cameraClock.advance();
+    for(int i = 0; i < steps; ++i)
+    {
+        prevEyeAngle = eyeAngle;
+        eyeAngle += g_eyeSpeed;
+    }
+    float angle = prevEyeAngle + (eyeAngle - prevEyeAngle) * (float)cameraClock.getAlpha();
+
+    eyePosition[0] = sin(angle) * g_eyeRadius; // x
+    eyePosition[2] = cos(angle) * g_eyeRadius; // z
 
     // tramsform camera
     //glRotatef(cameraAngleX, 1, 0, 0);   // pitch
     //glRotatef(eyePosition[0], 0, 1, 0);   // heading
 	//gluLookAt(eyePosition[0], eyePosition[1], eyePosition[2], 0, 0, 0, 0, 1, 0);
-	setCamera(eyePosition[0], g_eyeHeight, eyePosition[2], 0, 0, 0);
+    if(pathPlaying)
+    {
+        float time = (float)cameraClock.getTime();
+        Vec3 eye, target, up;
+        cameraPath.evaluate(time, eye, target, up);
+        camera.lookAt(eye, target, up);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadMatrixf(camera.getViewMatrix().get());
+        cameraPath.addFrame(time);
+    }
+    else if(trackballCamera)
+    {
+        // apply all mouse motion since last frame at once
+        updateTrackball();
+        camera.setViewMatrix(Mat4::translation(0, 0, -cameraDistance) * Mat4(&trackballMatrix[0][0]));
+        glMatrixMode(GL_MODELVIEW);
+        glLoadMatrixf(camera.getViewMatrix().get());
+    }
+    else
+    {
+        setCamera(eyePosition[0], g_eyeHeight, eyePosition[2], 0, 0, 0);
+    }
 
+    // sample a keyframe every PATH_KEY_STEPS camera steps
+    if(pathRecording)
+    {
+        for(int i = 0; i < steps; ++i)
+        {
+            if(++pathSteps % PATH_KEY_STEPS == 0)
+                recordCameraKey((float)(pathSteps * CAMERA_STEP));
+        }
+    }
 
-		// bind VBOs with IDs and set the buffer offsets of the bound VBOs
-// When buffer object is bound with its ID, all pointers in gl*Pointer()
-// are treated as offset instead of real pointer.
-	glBindBuffer(GL_ARRAY_BUFFER, vboId);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId);
+    // take the latest snapshot before the draw method branches, so the update
+    // phase covers the same work for both methods, plus the upload for instancing
+    // headless and --play runs step the objects by one frame, like the camera
+    if(simulation.isManual())
+        simulation.advance(CAMERA_STEP);
+    bool newSnapshot = glslSupported && simulation.acquire();
+    if(newSnapshot && drawMethod == DRAW_INSTANCED)
+    {
+        // send only the records modified since the last snapshot drawn
+        updateInstances();
+        frameUploadBytes = instanceBuffer.getBytesUploaded();
+    }
+    frameStats.endPhase(phaseUpdate);
 
-	// enable vertex arrays
-	glEnableClientState(GL_NORMAL_ARRAY);
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_VERTEX_ARRAY);
+    // bind VBOs with IDs and set the buffer offsets of the bound VBOs
+    // When buffer object is bound with its ID, all pointers in gl*Pointer()
+    // are treated as offset instead of real pointer.
+    glBindBuffer(GL_ARRAY_BUFFER, vboId);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId);
 
-	// before draw, specify vertex and index arrays with their offsets
-	glNormalPointer(GL_FLOAT, 0, (void*)sizeof(vertices));
-	glColorPointer(3, GL_FLOAT, 0, (void*)(sizeof(vertices) + sizeof(normals)));
-	glVertexPointer(3, GL_FLOAT, 0, 0);
+    // enable vertex arrays
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
 
-	glDrawElements(GL_TRIANGLES,            // primitive type
-						72,                      // # of indices
-						GL_UNSIGNED_INT,         // data type
-						(void*)0);               // ptr to indices
+    // before draw, specify vertex and index arrays with their offsets
+    glNormalPointer(GL_FLOAT, 0, (void*)sizeof(vertices));
+    glColorPointer(3, GL_FLOAT, 0, (void*)(sizeof(vertices) + sizeof(normals)));
+    glVertexPointer(3, GL_FLOAT, 0, 0);
 
-        glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
-        glDisableClientState(GL_COLOR_ARRAY);
-        glDisableClientState(GL_NORMAL_ARRAY);
+    if(glslSupported && drawMethod == DRAW_INSTANCED)
+    {
+        // per-instance attribute advances once per cube instead of per vertex
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.getId());
+        for(int i = 0; i < 3; ++i)
+        {
+            glEnableVertexAttribArray(instanceAttribs[i]);
+            glVertexAttribPointer(instanceAttribs[i], 4, GL_FLOAT, GL_FALSE, instanceBuffer.getStride(),
+                                  (void*)(i * 4 * sizeof(float)));
+            glVertexAttribDivisor(instanceAttribs[i], 1);
+        }
+
+        glUseProgram(progId);
+        if(uploadedCameraVersion != camera.getVersion())
+        {
+            // program uniforms persist, so send the matrices only when changed
+            glUniformMatrix4fv(uniformViewMatrix, 1, GL_FALSE, camera.getViewMatrix().get());
+            glUniformMatrix4fv(uniformViewProjectionMatrix, 1, GL_FALSE, camera.getViewProjectionMatrix().get());
+            uploadedCameraVersion = camera.getVersion();
+        }
+        glDrawElementsInstanced(GL_TRIANGLES, 72, GL_UNSIGNED_INT, (void*)0, instanceBuffer.getCount());
+        glUseProgram(0);
+        ++frameDrawCalls;
+        frameTriangles += 24LL * instanceBuffer.getCount();
+
+        for(int i = 0; i < 3; ++i)
+        {
+            glVertexAttribDivisor(instanceAttribs[i], 0);
+            glDisableVertexAttribArray(instanceAttribs[i]);
+        }
+    }
+    else if(glslSupported)
+    {
+        // one draw per object with fixed-function transform, for comparison
+        drawObjects();
+    }
+    else
+    {
+        glDrawElements(GL_TRIANGLES,            // primitive type
+                       72,                      // # of indices
+                       GL_UNSIGNED_INT,         // data type
+                       (void*)0);               // ptr to indices
+        ++frameDrawCalls;
+        frameTriangles += 24;
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    // it is good idea to release VBOs with ID 0 after use.
+    // Once bound with 0, all pointers in gl*Pointer() behave as real
+    // pointer, so, normal vertex array operations are re-activated
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    gpuTimer.end(GPU_SCENE);
+    frameStats.endPhase(phaseScene);
+
+    // particles are advanced with the same fixed steps as camera
+    gpuTimer.begin(GPU_EFFECTS);
+    if(particlesEnabled && particleSystem.isInitialized())
+    {
+        PROFILE_SCOPE("particles");
+        for(int i = 0; i < steps; ++i)
+            particleSystem.update((float)CAMERA_STEP);
+
+        // sprite size in pixels at unit distance
+        float halfFov = camera.getFovY() * 0.5f * 3.141593f / 180.0f;
+        particleSystem.draw(camera, PARTICLE_SIZE * camera.getViewportHeight() / (2 * tanf(halfFov)));
+        frameDrawCalls += steps + 1;            // points only, no triangles
+    }
+
+    if(labelsEnabled && labels.isInitialized())
+    {
+        drawLabels();
+        if(labels.getGlyphCount() > 0)
+        {
+            ++frameDrawCalls;
+            frameTriangles += 2LL * labels.getGlyphCount();
+        }
+    }
+    gpuTimer.end(GPU_EFFECTS);
+    frameStats.endPhase(phaseEffects);
 
-        // it is good idea to release VBOs with ID 0 after use.
-        // Once bound with 0, all pointers in gl*Pointer() behave as real
-        // pointer, so, normal vertex array operations are re-activated
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    
-
-    // draw a cube using vertex array method
-    // notice that only difference between VBO and VA is binding buffers and offsets
-	// update fps
-		myTime = glutGet(GLUT_ELAPSED_TIME);
-		if ((myTime - base_time) > 1000.0)
-		{
-			fps = frames * 1000.0 / (myTime - base_time);
-			base_time = myTime;
-			frames = 0;
-		}
     // draw info messages
+    gpuTimer.begin(GPU_HUD);
     showInfo();
+    gpuTimer.end(GPU_HUD);
+    instanceBuffer.resetStats();
+    if(hud.getDrawnGlyphCount() > 0)
+    {
+        ++frameDrawCalls;
+        frameTriangles += 2LL * hud.getDrawnGlyphCount();
+    }
+    frameStats.endPhase(phaseHud);
 
     glPopMatrix();
 
-    glutSwapBuffers();
-
+    gpuTimer.begin(GPU_SWAP);
+    {
+        PROFILE_SCOPE("swap");
+        if(headlessFrames > 0)
+            glFinish();                         // no swap to block on, wait for the frame to be drawn
+        else
+            glutSwapBuffers();
+    }
+    if(headlessFrames == 0)
+        framePacer.endFrame();
+    gpuTimer.end(GPU_SWAP);
+    gpuTimer.endFrame();
+    frameStats.endPhase(phaseSwap);
+    frameStats.endFrame();
+    GlCallCounter::endFrame();
+    debugOutput.endFrame();
+    GlCapture::endFrame();
+    BufferRegistry::validate();         // buffers added since the last frame, if --validate-buffers
+    if(reportFrames)
+        report.addFrame(frameStats, frameDrawCalls, frameTriangles, frameUploadBytes);
+
+    if(pathPlaying && cameraClock.getTime() >= cameraPath.getDuration())
+        stopPlayback();
 }
 
 
 void reshapeCB(int w, int h)
 {
+    PROFILE_FUNCTION();
     screenWidth = w;
     screenHeight = h;
     toPerspective();
@@ -653,6 +1636,7 @@ void reshapeCB(int w, int h)
 
 void timerCB(int millisec)
 {
+    PROFILE_FUNCTION();
     glutTimerFunc(millisec, timerCB, millisec);
     glutPostRedisplay();
 }
@@ -660,18 +1644,107 @@ void timerCB(int millisec)
 
 void idleCB()
 {
-    glutPostRedisplay();
+    PROFILE_FUNCTION();
+    // sleep until the next frame is due; skip it if it would look the same
+    // The time of a skipped frame is idle, not part of the next frame.
+    if(framePacer.waitNextFrame(isSceneIdle()))
+        glutPostRedisplay();
+    else
+        frameStats.restartInterval();
 }
 
 
 void keyboardCB(unsigned char key, int x, int y)
 {
+    PROFILE_FUNCTION();
+    framePacer.requestRedraw();
     switch(key)
     {
     case 27: // ESCAPE
         exit(0);
         break;
 
+    case '+':
+    case '=':
+        if(glslSupported)
+            simulation.addObjects(OBJECT_STEP);
+        break;
+
+    case '-':
+    case '_':
+        if(glslSupported)
+            simulation.removeObjects(OBJECT_STEP);
+        break;
+
+    case 'u':
+    case 'U':
+        updatePositions = !updatePositions;
+        simulation.setAnimated(updatePositions);
+        break;
+
+    case '[':
+        simulation.setMovingCount(simulation.getMovingCount() / 2);
+        break;
+
+    case ']':
+        if(simulation.getMovingCount() * 2 <= simulation.getObjectCount())
+            simulation.setMovingCount(simulation.getMovingCount() > 0 ? simulation.getMovingCount() * 2 : 1);
+        break;
+
+    case 'p':
+    case 'P':
+        particlesEnabled = !particlesEnabled;
+        break;
+
+    case 'l':
+    case 'L':
+        labelsEnabled = !labelsEnabled;
+        break;
+
+    case 'o':
+    case 'O':
+        trackballCamera = false;
+        break;
+
+    case 'r':
+    case 'R':
+        if(pathRecording)
+            stopRecording();
+        else if(!pathPlaying)
+            startRecording();
+        break;
+
+    case 'f':
+    case 'F':
+        if(pathPlaying)
+            stopPlayback();
+        else if(!pathRecording)
+            startPlayback();
+        break;
+
+    case 'c':
+    case 'C':
+        simulation.setCollision(!simulation.isCollision());
+        break;
+
+    case 'g':
+        dirtyRanges.setGapThreshold(dirtyRanges.getGapThreshold() / 2);
+        break;
+
+    case 'G':
+        dirtyRanges.setGapThreshold(dirtyRanges.getGapThreshold() > 0 ? dirtyRanges.getGapThreshold() * 2 : 1);
+        break;
+
+    case 'v':   // next frame pacing mode
+    case 'V':
+        framePacer.setMode((FramePacer::Mode)((framePacer.getMode() + 1) % FramePacer::MODE_COUNT));
+        break;
+
+    case 't':   // save CPU profile of recent frames
+    case 'T':
+        Profiler::save(TRACE_FILE, TRACE_FRAMES);
+        break;
+
     case ' ':
         if(vboSupported)
             vboUsed = !vboUsed;
@@ -709,50 +1782,63 @@ void keyboardCB(unsigned char key, int x, int y)
 
 void mouseCB(int button, int state, int x, int y)
 {
-    //mouseX = x;
-    //mouseY = y;
-
-    //if(button == GLUT_LEFT_BUTTON)
-    //{
-    //    if(state == GLUT_DOWN)
-    //    {
-    //        mouseLeftDown = true;
-    //    }
-    //    else if(state == GLUT_UP)
-    //        mouseLeftDown = false;
-    //}
+    PROFILE_FUNCTION();
+    // apply the motion of the previous drag before starting a new one
+    updateTrackball();
+    framePacer.requestRedraw();
+    mouseX = pendingMouseX = x;
+    mouseY = pendingMouseY = y;
+
+    if(button == GLUT_LEFT_BUTTON)
+    {
+        if(state == GLUT_DOWN)
+        {
+            mouseLeftDown = true;
+            trackballCamera = true;
+        }
+        else if(state == GLUT_UP)
+            mouseLeftDown = false;
+    }
 
-    //else if(button == GLUT_RIGHT_BUTTON)
-    //{
-    //    if(state == GLUT_DOWN)
-    //    {
-    //        mouseRightDown = true;
-    //    }
-    //    else if(state == GLUT_UP)
-    //        mouseRightDown = false;
-    //}
+    else if(button == GLUT_RIGHT_BUTTON)
+    {
+        if(state == GLUT_DOWN)
+        {
+            mouseRightDown = true;
+            trackballCamera = true;
+        }
+        else if(state == GLUT_UP)
+            mouseRightDown = false;
+    }
 }
 
 
 void mouseMotionCB(int x, int y)
 {
-    //if(mouseLeftDown)
-    //{
-    //    cameraAngleY += (x - mouseX);
-    //    cameraAngleX += (y - mouseY);
-    //    mouseX = x;
-    //    mouseY = y;
-    //}
-    //if(mouseRightDown)
-    //{
-    //    cameraDistance -= (y - mouseY) * 0.2f;
-    //    mouseY = y;
-    //}
+    PROFILE_FUNCTION();
+    // only remember the latest position; the rotation is computed once per
+    // frame in updateTrackball(), however many events arrive in between
+    pendingMouseX = x;
+    pendingMouseY = y;
+    ++motionEvents;
+    if(!mouseMoved)
+    {
+        mouseMoved = true;
+        framePacer.requestRedraw();     // drawn at the next paced frame
+    }
 }
 
 
 
 void exitCB()
 {
+    GlCapture::stop();                  // frames captured so far, if the program quits early
+    if(glDebug)
+    {
+        debugOutput.release();
+        debugOutput.printReport(std::cout);
+    }
     clearSharedMem();
+    headlessContext.destroy();          // here, not in static destruction where GL wrappers may be gone
+    BufferRegistry::reportLeaks(std::cout);     // all owners are released by now
 }
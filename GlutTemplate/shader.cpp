@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+// shader.cpp
+// ==========
+// helper functions to compile and link GLSL programs
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include "shader.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compile a shader object, print the info log and return 0 if failed
+///////////////////////////////////////////////////////////////////////////////
+static GLuint compileShader(GLenum type, const char* source)
+{
+    GLuint id = glCreateShader(type);
+    glShaderSource(id, 1, &source, 0);
+    glCompileShader(id);
+
+    int status = 0;
+    glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+    if(status == GL_FALSE)
+    {
+        int length = 0;
+        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length + 1, '\0');
+        glGetShaderInfoLog(id, length, 0, &log[0]);
+        std::cout << "[createShaderProgram()] Failed to compile "
+                  << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader:\n"
+                  << &log[0] << std::endl;
+        glDeleteShader(id);
+        id = 0;
+    }
+    return id;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create a GLSL program from vertex and fragment shader sources
+// Fragment shader source can be NULL for the programs used only for vertex
+// processing, for example, transform feedback.
+// If feedbackVaryings is given, these varyings are captured interleaved into
+// a single buffer during transform feedback. They must be set before link.
+// It returns 0 if compile or link is failed.
+///////////////////////////////////////////////////////////////////////////////
+GLuint createShaderProgram(const char* vsSource, const char* fsSource,
+                           const char** feedbackVaryings, int feedbackCount)
+{
+    GLuint vsId = compileShader(GL_VERTEX_SHADER, vsSource);
+    GLuint fsId = fsSource ? compileShader(GL_FRAGMENT_SHADER, fsSource) : 0;
+    if(!vsId || (fsSource && !fsId))
+    {
+        glDeleteShader(vsId);
+        glDeleteShader(fsId);
+        return 0;
+    }
+
+    GLuint id = glCreateProgram();
+    glAttachShader(id, vsId);
+    if(fsId)
+        glAttachShader(id, fsId);
+    if(feedbackVaryings && feedbackCount > 0)
+        glTransformFeedbackVaryings(id, feedbackCount, feedbackVaryings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(id);
+
+    // shader objects are flagged for deletion, freed when program is deleted
+    glDeleteShader(vsId);
+    glDeleteShader(fsId);
+
+    int status = 0;
+    glGetProgramiv(id, GL_LINK_STATUS, &status);
+    if(status == GL_FALSE)
+    {
+        int length = 0;
+        glGetProgramiv(id, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length + 1, '\0');
+        glGetProgramInfoLog(id, length, 0, &log[0]);
+        std::cout << "[createShaderProgram()] Failed to link program:\n" << &log[0] << std::endl;
+        glDeleteProgram(id);
+        id = 0;
+    }
+    return id;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// destroy a GLSL program
+///////////////////////////////////////////////////////////////////////////////
+void deleteShaderProgram(GLuint programId)
+{
+    if(programId)
+        glDeleteProgram(programId);
+}
@@ -0,0 +1,19 @@
+///////////////////////////////////////////////////////////////////////////////
+// shader.h
+// ========
+// helper functions to compile and link GLSL programs
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHADER_H
+#define SHADER_H
+
+#include "glExtension.h"
+
+GLuint createShaderProgram(const char* vsSource, const char* fsSource,
+                           const char** feedbackVaryings=0, int feedbackCount=0);
+void deleteShaderProgram(GLuint programId);
+
+#endif
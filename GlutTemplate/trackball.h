@@ -61,6 +61,12 @@ trackball(float q[4], float p1x, float p1y, float p2x, float p2y);
 void
 add_quats(float *q1, float *q2, float *dest);
 
+/*
+ * Scale a quaternion back to unit length, dividing by its magnitude.
+ */
+void
+normalize_quat(float q[4]);
+
 /*
  * A useful function, builds a rotation matrix in Matrix based on
  * given quaternion.
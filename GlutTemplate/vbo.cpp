@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// vbo.cpp
+// =======
+// helper functions to create and destroy OpenGL vertex buffer objects
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "vbo.h"
+#include "Profiler.h"
+#include "BufferRegistry.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// generate vertex buffer object and bind it with its data
+// You must give 2 hints about data usage; target and mode, so that OpenGL can
+// decide which data should be stored and its location.
+// VBO works with 2 different targets; GL_ARRAY_BUFFER for vertex arrays
+// and GL_ELEMENT_ARRAY_BUFFER for index array in glDrawElements().
+// The default target is GL_ARRAY_BUFFER.
+// By default, usage mode is set as GL_STATIC_DRAW.
+// Other usages are GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY,
+// GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY,
+// GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY.
+// The size is not read back here, which would wait for the driver; the
+// buffer is registered, and BufferRegistry::validate() checks it later.
+///////////////////////////////////////////////////////////////////////////////
+GLuint createVBO(const void* data, int dataSize, GLenum target, GLenum usage, const char* owner)
+{
+    PROFILE_FUNCTION();
+    GLuint id = 0;  // 0 is reserved, glGenBuffersARB() will return non-zero id if success
+
+    glGenBuffers(1, &id);                           // create a vbo
+    glBindBuffer(target, id);                       // activate vbo id to use
+    glBufferData(target, dataSize, data, usage);    // upload data to video card
+    BufferRegistry::add(id, target, usage, dataSize, owner);
+
+    return id;      // return VBO id
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// destroy a VBO
+// If VBO id is not valid or zero, then OpenGL ignores it silently.
+///////////////////////////////////////////////////////////////////////////////
+void deleteVBO(GLuint vboId)
+{
+    PROFILE_FUNCTION();
+    BufferRegistry::remove(vboId);
+    glDeleteBuffers(1, &vboId);
+}
@@ -0,0 +1,22 @@
+///////////////////////////////////////////////////////////////////////////////
+// vbo.h
+// =====
+// helper functions to create and destroy OpenGL vertex buffer objects
+//
+// The buffers are registered in BufferRegistry with the owner name given to
+// createVBO(), which must stay valid until the buffer is deleted.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VBO_H
+#define VBO_H
+
+#include "glExtension.h"
+
+GLuint createVBO(const void* data, int dataSize, GLenum target=GL_ARRAY_BUFFER, GLenum usage=GL_STATIC_DRAW,
+                 const char* owner=0);
+void deleteVBO(GLuint vboId);
+
+#endif